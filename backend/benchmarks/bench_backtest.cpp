@@ -0,0 +1,83 @@
+// Replay throughput for BacktestEngine on a synthetic random walk.
+// Usage: bench_backtest [ticks] [symbols]
+#include "backtest_engine.hpp"
+#include <spdlog/spdlog.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+    // Trades only when the price crosses its own running mean, so most
+    // ticks exercise the replay path rather than order handling
+    class CrossoverStrategy : public Strategy {
+    public:
+        void initialize() override { states_.clear(); }
+
+        std::vector<Signal> onMarketData(const MarketData& data) override {
+            if (data.symbol_id >= states_.size()) {
+                states_.resize(data.symbol_id + 1);
+            }
+            State& state = states_[data.symbol_id];
+            state.mean += 0.01 * (data.last_price - state.mean);
+            bool above = data.last_price > state.mean;
+            if (above == state.above) {
+                return {};
+            }
+            state.above = above;
+            return {Signal{data.symbol_id, above ? OrderSide::BUY : OrderSide::SELL, 0.1, data.timestamp}};
+        }
+
+        void onOrderUpdate(const Order&) override {}
+
+    private:
+        struct State {
+            double mean = 100.0;
+            bool above = false;
+        };
+        std::vector<State> states_;
+    };
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    size_t num_symbols = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20;
+    spdlog::set_level(spdlog::level::warn);
+
+    std::vector<SymbolId> symbols;
+    for (size_t i = 0; i < num_symbols; ++i) {
+        symbols.push_back(internSymbol("BT" + std::to_string(i)));
+    }
+    std::vector<double> prices(num_symbols, 100.0);
+    std::vector<MarketData> ticks(count);
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t s = i % num_symbols;
+        prices[s] *= 1.0 + ((static_cast<double>(state >> 11) * 0x1.0p-53) - 0.5) * 0.002;
+        ticks[i].symbol_id = symbols[s];
+        ticks[i].last_price = prices[s];
+        ticks[i].volume = 100.0;
+        ticks[i].timestamp = Timestamp(std::chrono::milliseconds(i));
+    }
+
+    CrossoverStrategy strategy;
+    BacktestEngine::Options options;
+    options.initial_capital = 1e7;
+    options.record_trades = false;
+    BacktestEngine engine(strategy, options);
+    BacktestResult result = engine.run(ticks);
+
+    std::printf("backtest: %zu ticks, %zu symbols, %llu orders, %llu fills\n", count, num_symbols,
+                static_cast<unsigned long long>(result.orders_submitted),
+                static_cast<unsigned long long>(result.fills));
+    std::printf("  %.2f M events/s, return %.2f%%, max drawdown %.2f%%\n",
+                result.events / result.elapsed_seconds / 1e6,
+                result.total_return * 100.0, result.max_drawdown * 100.0);
+    return 0;
+}
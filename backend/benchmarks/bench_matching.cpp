@@ -0,0 +1,104 @@
+// Throughput benchmark for MatchingEngine alone and for the full
+// OrderExecutor -> SimulatedExchange round trip.
+// Usage: bench_matching [orders]
+#include "matching_engine.hpp"
+#include "order_executor.hpp"
+#include "simulated_exchange.hpp"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+    // Limit orders around a fixed mid with a share of crossing and
+    // cancelled flow, so the book stays a realistic depth
+    std::vector<Order> makeFlow(SymbolId symbol, size_t count) {
+        std::vector<Order> orders;
+        orders.reserve(count);
+        uint64_t state = 88172645463325252ull;
+        for (size_t i = 0; i < count; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            OrderSide side = (state & 1) ? OrderSide::BUY : OrderSide::SELL;
+            bool market = (state >> 1) % 16 == 0;
+            int offset = static_cast<int>((state >> 8) % 20) - 5;
+            Order order(symbol, side, market ? OrderType::MARKET : OrderType::LIMIT,
+                        1.0 + static_cast<double>((state >> 16) % 100));
+            double price = 100.0 + (side == OrderSide::BUY ? -offset : offset) * 0.01;
+            order.setPrice(price);
+            orders.push_back(order);
+        }
+        return orders;
+    }
+
+    double seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    // Per-order info logs would dominate the executor numbers
+    spdlog::set_level(spdlog::level::warn);
+    SymbolId symbol = internSymbol("BENCH");
+    std::vector<Order> flow = makeFlow(symbol, count);
+
+    // Matching engine alone, closed book
+    {
+        MatchingEngine::Options options;
+        options.outside_liquidity = false;
+        MatchingEngine engine(options);
+        size_t fills = 0;
+        engine.setReportSink([&](const ExecutionReport& report) {
+            fills += report.type == ExecutionReport::Type::FILL;
+        });
+        Timestamp now = std::chrono::system_clock::now();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < flow.size(); ++i) {
+            engine.submit(flow[i], now);
+            if (i % 4 == 3) {
+                engine.cancel(flow[i - 2].getOrderId(), now);
+            }
+        }
+        double elapsed = seconds(start);
+        std::printf("matching engine: %zu orders, %zu fills, %zu resting\n",
+                    flow.size(), fills, engine.getOpenOrderCount());
+        std::printf("  %.2f M orders/s\n", flow.size() / elapsed / 1e6);
+    }
+
+    // Executor round trip: queue, lifecycle, exchange and update batches
+    {
+        OrderPool pool(count);
+        OrderExecutor::Options executor_options;
+        executor_options.queue_capacity = 65536;
+        executor_options.status_retention = 1024;
+        OrderExecutor executor(pool, executor_options);
+        SimulatedExchange::Options exchange_options;
+        exchange_options.simulated_clock = true;
+        exchange_options.matching.outside_liquidity = false;
+        executor.setVenue(std::make_unique<SimulatedExchange>(exchange_options));
+        size_t updates = 0;
+        executor.setUpdateHandler([&](Span<const OrderUpdate> batch) { updates += batch.size(); });
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < flow.size(); ++i) {
+            const Order& source = flow[i];
+            Order* order = pool.acquire(source.getSymbol(), source.getSide(), source.getType(),
+                                        source.getQuantity());
+            order->setPrice(source.getPrice());
+            executor.submitOrder(order);
+            if (i % 1024 == 1023) {
+                executor.drain();
+            }
+        }
+        executor.drain();
+        double elapsed = seconds(start);
+        std::printf("executor + simulated exchange: %zu orders, %zu updates\n", flow.size(), updates);
+        std::printf("  %.2f M orders/s\n", flow.size() / elapsed / 1e6);
+    }
+    return 0;
+}
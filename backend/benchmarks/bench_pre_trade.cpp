@@ -0,0 +1,83 @@
+// Latency benchmark for RiskManager::checkOrder.
+// Usage: bench_pre_trade [iterations] [positions]
+#include "risk_manager.hpp"
+#include "order_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace trading;
+
+namespace {
+    constexpr double kTargetP99Nanos = 1000.0;
+
+    double percentile(std::vector<double>& samples, double p) {
+        size_t index = static_cast<size_t>(p * (samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index];
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t num_positions = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500;
+
+    PriceTable prices;
+    Portfolio portfolio(100000000.0);
+    std::vector<SymbolId> symbols;
+    for (size_t i = 0; i < num_positions; ++i) {
+        SymbolId symbol = internSymbol("SYM" + std::to_string(i));
+        MarketData tick;
+        tick.symbol_id = symbol;
+        tick.last_price = 10.0 + static_cast<double>(i % 200);
+        prices.update(tick);
+        portfolio.applyFill(symbol, 100.0, tick.last_price);
+        symbols.push_back(symbol);
+    }
+
+    RiskManager::RiskLimits limits{0.1, 0.2, 2.0, 0.05, 0.3};
+    RiskManager risk_manager(limits, &prices);
+
+    // Pre-built orders so the loop measures only the check
+    OrderPool pool(num_positions);
+    std::vector<Order*> orders;
+    for (size_t i = 0; i < num_positions; ++i) {
+        orders.push_back(pool.acquire(symbols[i], i % 2 ? OrderSide::SELL : OrderSide::BUY,
+                                      OrderType::MARKET, 10.0 + static_cast<double>(i)));
+    }
+
+    // Warm caches and branch predictors
+    size_t accepted = 0;
+    for (size_t i = 0; i < 100000; ++i) {
+        accepted += risk_manager.checkOrder(*orders[i % orders.size()], portfolio).accepted();
+    }
+
+    std::vector<double> samples(iterations);
+    auto total_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        const Order& order = *orders[(i * 7919) % orders.size()];
+        auto start = std::chrono::steady_clock::now();
+        RiskVerdict verdict = risk_manager.checkOrder(order, portfolio);
+        auto end = std::chrono::steady_clock::now();
+        accepted += verdict.accepted();
+        samples[i] = std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    auto total_end = std::chrono::steady_clock::now();
+    double total_nanos = std::chrono::duration<double, std::nano>(total_end - total_start).count();
+
+    double p50 = percentile(samples, 0.50);
+    double p99 = percentile(samples, 0.99);
+    double p999 = percentile(samples, 0.999);
+    double max = *std::max_element(samples.begin(), samples.end());
+
+    std::printf("pre-trade check: %zu iterations, %zu positions (accepted %zu)\n",
+                iterations, num_positions, accepted);
+    std::printf("  p50 %.0f ns  p99 %.0f ns  p99.9 %.0f ns  max %.0f ns\n", p50, p99, p999, max);
+    std::printf("  throughput %.1f M checks/s (including timer overhead)\n",
+                iterations / total_nanos * 1e3);
+    std::printf("  p99 target %.0f ns: %s\n", kTargetP99Nanos, p99 < kTargetP99Nanos ? "PASS" : "FAIL");
+    return p99 < kTargetP99Nanos ? 0 : 1;
+}
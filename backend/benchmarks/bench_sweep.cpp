@@ -0,0 +1,62 @@
+// Scaling benchmark for ParameterSweep: one moving-average grid replayed
+// from a mapped TickFile at increasing thread counts.
+// Usage: bench_sweep [ticks] [max_threads]
+#include "parameter_sweep.hpp"
+#include "tick_file.hpp"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace trading;
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    size_t max_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    spdlog::set_level(spdlog::level::warn);
+
+    std::vector<MarketData> ticks(count);
+    SymbolId symbol = internSymbol("SWEEP");
+    double price = 100.0;
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        price *= 1.0 + ((static_cast<double>(state >> 11) * 0x1.0p-53) - 0.5) * 0.002;
+        ticks[i].symbol_id = symbol;
+        ticks[i].last_price = price;
+        ticks[i].volume = 100.0;
+        ticks[i].timestamp = Timestamp(std::chrono::seconds(i));
+    }
+    std::string path = "/tmp/bench_sweep_" + std::to_string(::getpid()) + ".ticks";
+    TickFile::write(path, ticks);
+    ticks.clear();
+    ticks.shrink_to_fit();
+    TickFile file(path);
+
+    SweepSpec spec;
+    spec.parameters = {{"short_period", 2, 40, 2, true}, {"long_period", 20, 200, 10, true}};
+
+    double baseline = 0.0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ParameterSweep::Options options;
+        options.threads = threads;
+        options.backtest.order_pool_capacity = 4096;
+        ParameterSweep sweep(movingAverageFactory(), options);
+        auto start = std::chrono::steady_clock::now();
+        auto results = sweep.run(spec, file.ticks());
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) {
+            baseline = elapsed;
+        }
+        std::printf("%2zu threads: %zu evaluations in %.2fs, speedup %.2fx\n",
+                    threads, results.size(), elapsed, baseline / elapsed);
+    }
+    std::remove(path.c_str());
+    return 0;
+}
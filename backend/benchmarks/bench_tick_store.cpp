@@ -0,0 +1,132 @@
+// Tick store benchmark: writes the same data raw and packed, then times
+// opening each store and a scan of every chunk (find + load, summing
+// price * volume). The files are in the page cache after writing, so
+// these are warm-cache numbers.
+// Usage: bench_tick_store [symbols] [days] [bars|ticks]
+#include "tick_store.hpp"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace trading;
+
+namespace {
+    constexpr int64_t kFirstDay = 19723;  // 2024-01-01
+    constexpr int64_t kNanosPerMinute = 60000000000LL;
+    constexpr int64_t kSessionOpen = 570 * kNanosPerMinute;
+    constexpr int64_t kSessionLength = 390 * kNanosPerMinute;
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Xorshift {
+        uint64_t state = 88172645463325252ull;
+        uint64_t operator()() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+    };
+
+    // One symbol: minute bars, or trades at microsecond resolution with
+    // random gaps. Prices on a cent grid, volumes in shares.
+    void generate(SymbolId symbol, size_t days, bool bars, Xorshift& rng, std::vector<MarketData>& out) {
+        out.clear();
+        int64_t cents = 10000;
+        size_t per_day = bars ? 390 : 20000;
+        for (size_t d = 0; d < days; ++d) {
+            int64_t open = (kFirstDay + static_cast<int64_t>(d)) * 1440 * kNanosPerMinute + kSessionOpen;
+            int64_t time = open;
+            for (size_t i = 0; i < per_day; ++i) {
+                MarketData tick;
+                tick.symbol_id = symbol;
+                uint64_t draw = rng();
+                if (bars) {
+                    time = open + static_cast<int64_t>(i) * kNanosPerMinute;
+                } else {
+                    time += static_cast<int64_t>(draw % (2 * kSessionLength / per_day / 1000)) * 1000;
+                }
+                tick.timestamp = fromEpochNanos(time);
+                int64_t open_cents = cents;
+                cents = std::max<int64_t>(2, cents + static_cast<int64_t>((draw >> 20) % 21) - 10);
+                tick.open = static_cast<double>(open_cents) / 100.0;
+                tick.last_price = static_cast<double>(cents) / 100.0;
+                tick.high = static_cast<double>(std::max(open_cents, cents) + 1) / 100.0;
+                tick.low = static_cast<double>(std::min(open_cents, cents) - 1) / 100.0;
+                tick.volume = static_cast<double>(bars ? 100 + (draw >> 40) % 5000 : 100 * (1 + (draw >> 40) % 10));
+                out.push_back(tick);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t symbols = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+    size_t days = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 21;
+    bool bars = argc <= 3 || std::strcmp(argv[3], "ticks") != 0;
+    spdlog::set_level(spdlog::level::warn);
+
+    std::string base = "/tmp/bench_tick_store_" + std::to_string(::getpid());
+    std::string paths[2] = {base + ".raw", base + ".packed"};
+    const char* names[2] = {"raw", "packed"};
+    TickStoreWriter::Compression compressions[2] = {TickStoreWriter::Compression::NONE,
+                                                    TickStoreWriter::Compression::PACKED};
+
+    size_t rows = 0;
+    {
+        TickStoreWriter raw(paths[0], compressions[0]);
+        TickStoreWriter packed(paths[1], compressions[1]);
+        Xorshift rng;
+        std::vector<MarketData> ticks;
+        auto layout = bars ? TickStoreWriter::Layout::BARS : TickStoreWriter::Layout::TICKS;
+        for (size_t s = 0; s < symbols; ++s) {
+            generate(internSymbol("SYM" + std::to_string(s)), days, bars, rng, ticks);
+            raw.append(ticks, layout);
+            packed.append(ticks, layout);
+            rows += ticks.size();
+        }
+    }
+    std::printf("%zu symbols x %zu days: %zu %s\n", symbols, days, rows, bars ? "minute bars" : "ticks");
+
+    double raw_bytes = 0.0;
+    for (int i = 0; i < 2; ++i) {
+        struct stat info;
+        ::stat(paths[i].c_str(), &info);
+        double bytes = static_cast<double>(info.st_size);
+        if (i == 0) {
+            raw_bytes = bytes;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        TickStore store(paths[i]);
+        double open_ms = secondsSince(start) * 1e3;
+
+        start = std::chrono::steady_clock::now();
+        TickStore::Buffer buffer;
+        double checksum = 0.0;
+        size_t scanned = 0;
+        for (SymbolId symbol : store.symbols()) {
+            for (const auto& entry : store.find(symbol)) {
+                TickStore::Chunk chunk = store.load(entry, buffer);
+                for (size_t r = 0; r < chunk.size(); ++r) {
+                    checksum += chunk.prices[r] * chunk.volumes[r];
+                }
+                scanned += chunk.size();
+            }
+        }
+        double elapsed = secondsSince(start);
+        std::printf("%-6s %8.1f MB (%5.2f B/row, %4.1fx)  open %.3fms  scan %6.1fM rows/s  checksum %.6g\n",
+                    names[i], bytes / 1e6, bytes / rows, raw_bytes / bytes, open_ms, scanned / elapsed / 1e6,
+                    checksum);
+        std::remove(paths[i].c_str());
+    }
+    return 0;
+}
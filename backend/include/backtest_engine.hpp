@@ -0,0 +1,113 @@
+#pragma once
+#include "common/span.hpp"
+#include "common/types.hpp"
+#include "order_executor.hpp"
+#include "order_pool.hpp"
+#include "portfolio.hpp"
+#include "price_table.hpp"
+#include "risk_manager.hpp"
+#include "simulated_exchange.hpp"
+#include "strategy.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace trading {
+
+class HistoricalStream;
+
+struct EquityPoint {
+    Timestamp timestamp;
+    double total_value;
+    double cash;
+    double drawdown;
+};
+
+struct TradeRecord {
+    Timestamp timestamp;
+    SymbolId symbol;
+    OrderSide side;
+    double quantity;
+    double price;
+    double commission;
+    OrderId order_id;
+};
+
+struct BacktestResult {
+    double initial_capital = 0.0;
+    double final_value = 0.0;
+    double total_return = 0.0;
+    double max_drawdown = 0.0;
+    double realized_pnl = 0.0;
+    double commission = 0.0;
+    uint64_t events = 0;
+    uint64_t orders_submitted = 0;
+    uint64_t orders_rejected = 0;  // By the risk checks
+    uint64_t fills = 0;
+    double elapsed_seconds = 0.0;  // Wall time spent replaying
+    std::vector<EquityPoint> equity_curve;
+    std::vector<TradeRecord> trades;
+};
+
+// Replays historical ticks through the production path: Strategy signals
+// are sized and checked by RiskManager, then routed by OrderExecutor to a
+// SimulatedExchange on a simulated clock driven by tick timestamps. Fills
+// come back as OrderUpdates and are applied to the Portfolio and
+// Strategy::onOrderUpdate exactly as in the live engine.
+//
+// Single-threaded: the executor is drained synchronously after each
+// tick, so a run is deterministic for a given tick sequence. The live
+// engine's throttle and kill switch work on wall time and are not used.
+class BacktestEngine {
+public:
+    struct Options {
+        double initial_capital = 100000.0;
+        double position_size_limit = 0.1;  // Share of portfolio value at full signal strength
+        double commission_rate = 0.0;      // Fraction of traded notional
+        // Fractions of portfolio value; by default only leverage binds
+        RiskLimits limits{1.0, 1.0, 10.0, 1.0, 1.0};
+        SimulatedExchange::Options exchange;  // simulated_clock is always on
+        size_t order_pool_capacity = 65536;  // Open orders; also sizes the order table
+        // Simulated time between equity curve points; zero records none
+        std::chrono::nanoseconds equity_interval = std::chrono::hours(24);
+        bool record_trades = true;
+    };
+
+    // strategy must outlive the engine
+    BacktestEngine(Strategy& strategy, const Options& options);
+
+    // Replays ticks in order; they must be sorted by timestamp
+    BacktestResult run(Span<const MarketData> ticks);
+
+    // Replays every batch of stream; memory stays bounded by the stream
+    BacktestResult run(HistoricalStream& stream);
+
+    // Incremental form of run() for sources too large to hold in memory
+    void begin();
+    void onTick(const MarketData& tick);
+    BacktestResult finish();
+
+    const Portfolio& getPortfolio() const { return portfolio_; }
+
+private:
+    void onUpdates(Span<const OrderUpdate> updates);
+    void processSignals(const std::vector<Strategy::Signal>& signals);
+    void recordEquity(Timestamp now);
+
+    Strategy& strategy_;
+    Options options_;
+    OrderPool order_pool_;
+    PriceTable price_table_;
+    Portfolio portfolio_;
+    RiskManager risk_manager_;
+    SimulatedExchange* exchange_ = nullptr;  // Owned by executor_
+    std::unique_ptr<OrderExecutor> executor_;
+    std::vector<Order*> pending_orders_;
+    std::vector<RiskVerdict> pending_verdicts_;
+    BacktestResult result_;
+    Timestamp next_equity_{};
+    Timestamp last_tick_{};
+    std::chrono::steady_clock::time_point started_{};
+};
+
+} // namespace trading
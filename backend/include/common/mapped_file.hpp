@@ -0,0 +1,117 @@
+#pragma once
+#include "common/span.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace trading {
+
+// Read-only memory mapping of a whole file. Pages are shared through the
+// page cache, so any number of threads (or processes) can read one copy
+// of the data without loading it. Move-only.
+class MappedFile {
+public:
+    enum class Advice {
+        NORMAL = MADV_NORMAL,
+        SEQUENTIAL = MADV_SEQUENTIAL,
+        RANDOM = MADV_RANDOM,
+        WILL_NEED = MADV_WILLNEED,
+        DONT_NEED = MADV_DONTNEED
+    };
+
+    MappedFile() = default;
+
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot stat " + path + ": " + std::strerror(error));
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::runtime_error("Cannot map " + path + ": " + std::strerror(error));
+            }
+            data_ = static_cast<const uint8_t*>(address);
+        }
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+    }
+
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isOpen() const { return data_ != nullptr; }
+
+    // Typed view of count elements at offset. Throws if the range is out
+    // of bounds or misaligned for T.
+    template <typename T>
+    Span<const T> view(size_t offset, size_t count) const {
+        if (offset > size_ || count > (size_ - offset) / sizeof(T)) {
+            throw std::out_of_range("Mapped range out of bounds");
+        }
+        if (reinterpret_cast<uintptr_t>(data_ + offset) % alignof(T) != 0) {
+            throw std::invalid_argument("Mapped range misaligned");
+        }
+        return {reinterpret_cast<const T*>(data_ + offset), count};
+    }
+
+    // Access pattern hint for [offset, offset + length); length 0 means to
+    // the end. Best effort: errors are ignored.
+    void advise(Advice advice, size_t offset = 0, size_t length = 0) const {
+        if (!data_ || offset >= size_) {
+            return;
+        }
+        // madvise needs a page-aligned start
+        static const size_t kPageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t start = offset & ~(kPageSize - 1);
+        size_t end = (length == 0 || length > size_ - offset) ? size_ : offset + length;
+        ::madvise(const_cast<uint8_t*>(data_ + start), end - start, static_cast<int>(advice));
+    }
+
+private:
+    void unmap() {
+        if (data_) {
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace trading
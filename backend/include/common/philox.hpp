@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace trading {
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3"). The output is a pure function of
+// (counter, key), so any thread can produce draw i of stream k without
+// sharing state, and results do not depend on how work is split.
+class Philox4x32 {
+public:
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    explicit Philox4x32(uint64_t seed)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+    explicit Philox4x32(const Key& key) : key_(key) {}
+
+    Counter operator()(Counter counter) const {
+        Key key = key_;
+        for (int round = 0; round < 10; ++round) {
+            counter = singleRound(counter, key);
+            key[0] += kWeyl0;
+            key[1] += kWeyl1;
+        }
+        return counter;
+    }
+
+    // Four standard normals for (stream, index) via Box-Muller
+    std::array<double, 4> normals(uint64_t stream, uint32_t index) const {
+        Counter bits = (*this)({static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32),
+                                index, 0});
+        std::array<double, 4> out;
+        boxMuller(bits[0], bits[1], out[0], out[1]);
+        boxMuller(bits[2], bits[3], out[2], out[3]);
+        return out;
+    }
+
+    // Uniform in (0, 1), never exactly 0 or 1
+    static double toUniform(uint32_t bits) { return (bits + 0.5) * (1.0 / 4294967296.0); }
+
+private:
+    static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+    static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+    static Counter singleRound(const Counter& counter, const Key& key) {
+        uint64_t product0 = uint64_t(kMultiplier0) * counter[0];
+        uint64_t product1 = uint64_t(kMultiplier1) * counter[2];
+        return {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<uint32_t>(product1),
+                static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<uint32_t>(product0)};
+    }
+
+    static void boxMuller(uint32_t a, uint32_t b, double& z0, double& z1) {
+        constexpr double kTwoPi = 6.283185307179586476925286766559;
+        double radius = std::sqrt(-2.0 * std::log(toUniform(a)));
+        double angle = kTwoPi * toUniform(b);
+        z0 = radius * std::cos(angle);
+        z1 = radius * std::sin(angle);
+    }
+
+    Key key_;
+};
+
+} // namespace trading
@@ -0,0 +1,261 @@
+#pragma once
+#include "common/types.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace trading {
+
+// How a consumer waits on an empty queue
+enum class WaitStrategy {
+    SPIN,   // Busy-spin with a pause hint, lowest latency, burns a core
+    YIELD,  // Spin with std::this_thread::yield()
+    BLOCK   // Brief spin, then sleep on a futex until a producer signals
+};
+
+// Consumer-side wait primitive shared by the ring queues. Producers call
+// notify() after a push; it is a single atomic load unless the consumer is
+// actually asleep, so the SPIN and YIELD paths never make a syscall.
+class QueueWaiter {
+public:
+    explicit QueueWaiter(WaitStrategy strategy) : strategy_(strategy) {}
+
+    WaitStrategy strategy() const { return strategy_; }
+
+    // Waits until ready() returns true or the deadline passes.
+    template <typename Ready>
+    bool waitUntil(Ready ready, std::chrono::steady_clock::time_point deadline) {
+        constexpr int kSpinsBeforeSleep = 128;
+        for (int spins = 0; ; ++spins) {
+            if (ready()) {
+                return true;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+
+            switch (strategy_) {
+                case WaitStrategy::SPIN:
+                    cpuRelax();
+                    break;
+                case WaitStrategy::YIELD:
+                    std::this_thread::yield();
+                    break;
+                case WaitStrategy::BLOCK:
+                    if (spins < kSpinsBeforeSleep) {
+                        cpuRelax();
+                    } else {
+                        sleep(ready, deadline);
+                    }
+                    break;
+            }
+        }
+    }
+
+    void notify() {
+        if (strategy_ != WaitStrategy::BLOCK) {
+            return;
+        }
+        // Pairs with the fence in sleep(): either the consumer sees the new
+        // element or we see it registered as a sleeper.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) > 0) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            wake();
+        }
+    }
+
+private:
+    template <typename Ready>
+    void sleep(Ready& ready, std::chrono::steady_clock::time_point deadline) {
+        sleepers_.fetch_add(1, std::memory_order_relaxed);
+        uint32_t epoch = epoch_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready()) {
+            waitOnEpoch(epoch, deadline);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void waitOnEpoch(uint32_t epoch, std::chrono::steady_clock::time_point deadline) {
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::steady_clock::duration::zero()) {
+            return;
+        }
+#ifdef __linux__
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(ns / 1000000000);
+        timeout.tv_nsec = static_cast<long>(ns % 1000000000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE,
+                epoch, &timeout, nullptr, 0);
+#else
+        // Portable fallback: short sleeps bounded by the deadline
+        auto step = std::chrono::microseconds(50);
+        while (epoch_.load(std::memory_order_acquire) == epoch &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+#endif
+    }
+
+    void wake() {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE,
+                INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    WaitStrategy strategy_;
+    alignas(kCacheLineSize) std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> sleepers_{0};
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex wait requires a plain 32-bit atomic");
+
+inline size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Bounded single-producer/single-consumer ring. Head and tail live on
+// separate cache lines and each side caches the other's index to avoid
+// touching the shared line on every operation.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : mask_(roundUpToPowerOfTwo(capacity) - 1), buffer_(mask_ + 1) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+    }
+
+    template <typename U>
+    bool tryPush(U&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        value = std::move(buffer_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    const size_t mask_;
+    std::vector<T> buffer_;
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;  // Consumer's view of tail_
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;  // Producer's view of head_
+};
+
+// Bounded multi-producer/single-consumer ring (Vyukov's sequenced cells).
+// Producers claim a slot with one CAS; the consumer never contends with them.
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t capacity)
+        : mask_(roundUpToPowerOfTwo(capacity) - 1), cells_(mask_ + 1) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename U>
+    bool tryPush(U&& value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::forward<U>(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;  // Empty, or a producer has not finished writing
+        }
+        value = std::move(cell.value);
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool empty() const {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        const Cell& cell = cells_[pos & mask_];
+        return cell.sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct alignas(kCacheLineSize) Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    const size_t mask_;
+    std::vector<Cell> cells_;
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+};
+
+} // namespace trading
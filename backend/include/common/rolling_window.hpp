@@ -0,0 +1,102 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace trading {
+
+// Running sum with Neumaier compensation, so long add/remove sequences
+// do not accumulate rounding drift.
+template <typename T>
+class CompensatedSum {
+public:
+    void add(T value) {
+        T t = sum_ + value;
+        if (std::abs(sum_) >= std::abs(value)) {
+            compensation_ += (sum_ - t) + value;
+        } else {
+            compensation_ += (value - t) + sum_;
+        }
+        sum_ = t;
+    }
+
+    void subtract(T value) { add(-value); }
+    T value() const { return sum_ + compensation_; }
+    void reset() { sum_ = T(0); compensation_ = T(0); }
+
+private:
+    T sum_ = T(0);
+    T compensation_ = T(0);
+};
+
+// Fixed-capacity ring buffer over the most recent values with O(1)
+// push, mean and variance. Memory is allocated once at construction.
+template <typename T = double>
+class RollingWindow {
+public:
+    explicit RollingWindow(size_t capacity) : buffer_(capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("RollingWindow capacity must be positive");
+        }
+    }
+
+    // Appends a value, evicting the oldest one once the window is full
+    void push(T value) {
+        if (size_ == buffer_.size()) {
+            T evicted = buffer_[head_];
+            sum_.subtract(evicted);
+            sum_squares_.subtract(evicted * evicted);
+        } else {
+            ++size_;
+        }
+        buffer_[head_] = value;
+        sum_.add(value);
+        sum_squares_.add(value * value);
+        head_ = (head_ + 1 == buffer_.size()) ? 0 : head_ + 1;
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+        sum_.reset();
+        sum_squares_.reset();
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return buffer_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == buffer_.size(); }
+
+    T sum() const { return sum_.value(); }
+    T mean() const { return size_ ? sum() / static_cast<T>(size_) : T(0); }
+
+    // Sample variance
+    T variance() const {
+        if (size_ < 2) {
+            return T(0);
+        }
+        T n = static_cast<T>(size_);
+        T var = (sum_squares_.value() - sum() * sum() / n) / (n - 1);
+        return var > T(0) ? var : T(0);
+    }
+
+    // Index 0 is the oldest value in the window
+    T operator[](size_t index) const {
+        size_t start = full() ? head_ : 0;
+        size_t pos = start + index;
+        return buffer_[pos >= buffer_.size() ? pos - buffer_.size() : pos];
+    }
+
+    T newest() const { return (*this)[size_ - 1]; }
+    T oldest() const { return (*this)[0]; }
+
+private:
+    std::vector<T> buffer_;
+    size_t head_ = 0;  // Next write position
+    size_t size_ = 0;
+    CompensatedSum<T> sum_;
+    CompensatedSum<T> sum_squares_;
+};
+
+} // namespace trading
@@ -0,0 +1,79 @@
+#pragma once
+#include "common/types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace trading {
+
+// Single-writer sequence lock for small trivially copyable values. The
+// writer never blocks; readers retry only if they overlap a write. The
+// payload is held as relaxed atomic words so concurrent reads are not
+// data races.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() {
+        for (auto& word : words_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    explicit SeqLock(const T& value) : SeqLock() { store(value); }
+
+    // Must only be called from one writer thread at a time
+    void store(const T& value) {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Returns false if a write was in progress; out is then unspecified
+    bool tryLoad(T& out) const {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    T load() const {
+        T value;
+        while (!tryLoad(value)) {
+            cpuRelax();
+        }
+        return value;
+    }
+
+    // Even and increasing; changes once per store
+    uint64_t sequence() const { return sequence_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> words_[kWords];
+};
+
+} // namespace trading
@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace trading {
+
+// Minimal non-owning view over contiguous elements, a C++17 stand-in for
+// std::span. Converts implicitly from vectors, arrays and (pointer, size).
+template <typename T>
+class Span {
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() = default;
+    constexpr Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename Alloc>
+    Span(std::vector<value_type, Alloc>& values) : data_(values.data()), size_(values.size()) {}
+
+    template <typename Alloc, typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    Span(const std::vector<value_type, Alloc>& values) : data_(values.data()), size_(values.size()) {}
+
+    template <size_t N>
+    constexpr Span(std::array<value_type, N>& values) : data_(values.data()), size_(N) {}
+
+    template <size_t N, typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    constexpr Span(const std::array<value_type, N>& values) : data_(values.data()), size_(N) {}
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr T& operator[](size_t index) const { return data_[index]; }
+
+    constexpr iterator begin() const { return data_; }
+    constexpr iterator end() const { return data_ + size_; }
+
+    constexpr Span subspan(size_t offset, size_t count) const { return {data_ + offset, count}; }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace trading
@@ -0,0 +1,103 @@
+#pragma once
+#include "common/types.hpp"
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace trading {
+
+// Assigns a symbol to one of num_shards workers. Interned IDs are dense,
+// so a modulo spreads symbols evenly.
+inline size_t shardOf(SymbolId symbol, size_t num_shards) {
+    return symbol % num_shards;
+}
+
+// Per-symbol state in a flat array indexed by SymbolId. Each slot starts on a
+// cache line and is padded to whole lines, so shards owning disjoint symbols
+// never share lines and can update their state without locks. Not safe for
+// concurrent growth: size the table up front with reserve() when it is shared
+// between shards.
+template <typename T>
+class SymbolStateTable {
+public:
+    SymbolStateTable() = default;
+    explicit SymbolStateTable(size_t capacity) { reserve(capacity); }
+
+    void reserve(size_t capacity) {
+        if (capacity > slots_.size()) {
+            slots_.resize(capacity);
+        }
+    }
+
+    // Returns the state for symbol, constructing it from args on first use
+    template <typename... Args>
+    T& getOrCreate(SymbolId symbol, Args&&... args) {
+        if (symbol >= slots_.size()) {
+            reserve(std::max<size_t>(symbol + 1, slots_.size() * 2));
+        }
+        auto& value = slots_[symbol].value;
+        if (!value) {
+            value.emplace(std::forward<Args>(args)...);
+        }
+        return *value;
+    }
+
+    T* find(SymbolId symbol) {
+        return (symbol < slots_.size() && slots_[symbol].value) ? &*slots_[symbol].value : nullptr;
+    }
+
+    const T* find(SymbolId symbol) const {
+        return (symbol < slots_.size() && slots_[symbol].value) ? &*slots_[symbol].value : nullptr;
+    }
+
+    bool contains(SymbolId symbol) const { return find(symbol) != nullptr; }
+
+    void erase(SymbolId symbol) {
+        if (symbol < slots_.size()) {
+            slots_[symbol].value.reset();
+        }
+    }
+
+    void clear() { slots_.clear(); }
+
+    size_t capacity() const { return slots_.size(); }
+
+    // Visits populated slots as f(SymbolId, T&)
+    template <typename F>
+    void forEach(F&& f) {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].value) {
+                f(static_cast<SymbolId>(i), *slots_[i].value);
+            }
+        }
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].value) {
+                f(static_cast<SymbolId>(i), *slots_[i].value);
+            }
+        }
+    }
+
+    // Visits populated slots owned by one shard
+    template <typename F>
+    void forEachInShard(size_t shard, size_t num_shards, F&& f) {
+        for (size_t i = shard; i < slots_.size(); i += num_shards) {
+            if (slots_[i].value) {
+                f(static_cast<SymbolId>(i), *slots_[i].value);
+            }
+        }
+    }
+
+private:
+    struct alignas(kCacheLineSize) Slot {
+        std::optional<T> value;
+    };
+
+    std::vector<Slot> slots_;
+};
+
+} // namespace trading
@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace trading {
+
+// Interned symbol identifier, dense from 0 in order of first use
+using SymbolId = uint32_t;
+constexpr SymbolId kInvalidSymbol = std::numeric_limits<SymbolId>::max();
+
+// Process-wide symbol interning. Interning takes a lock and is meant for the
+// edges (config, data adapters); name lookup by ID is lock-free.
+class SymbolTable {
+public:
+    static constexpr size_t kMaxSymbols = 16384;
+
+    static SymbolTable& instance() {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolId intern(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+
+        size_t id = size_.load(std::memory_order_relaxed);
+        if (id >= kMaxSymbols) {
+            throw std::runtime_error("Symbol table full, cannot intern " + name);
+        }
+        names_[id] = name;
+        ids_.emplace(name, static_cast<SymbolId>(id));
+        size_.store(id + 1, std::memory_order_release);
+        return static_cast<SymbolId>(id);
+    }
+
+    SymbolId find(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        return (it != ids_.end()) ? it->second : kInvalidSymbol;
+    }
+
+    const std::string& name(SymbolId id) const {
+        static const std::string unknown = "<unknown>";
+        return (id < size_.load(std::memory_order_acquire)) ? names_[id] : unknown;
+    }
+
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+private:
+    SymbolTable() : names_(new std::string[kMaxSymbols]), size_(0) {}
+
+    // Fixed storage so published names never move under lock-free readers
+    std::unique_ptr<std::string[]> names_;
+    std::unordered_map<std::string, SymbolId> ids_;
+    std::atomic<size_t> size_;
+    mutable std::mutex mutex_;
+};
+
+inline SymbolId internSymbol(const std::string& name) {
+    return SymbolTable::instance().intern(name);
+}
+
+inline const std::string& symbolName(SymbolId id) {
+    return SymbolTable::instance().name(id);
+}
+
+} // namespace trading
@@ -1,26 +1,115 @@
 #pragma once
+#include "common/symbol_table.hpp"
 #include <string>
 #include <vector>
 #include <chrono>
 #include <memory>
 #include <map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <thread>
 
 namespace trading {
 
 using Timestamp = std::chrono::system_clock::time_point;
 
+// Epoch nanoseconds, the wire and file representation of a Timestamp
+inline int64_t toEpochNanos(Timestamp timestamp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+inline Timestamp fromEpochNanos(int64_t nanos) {
+    return Timestamp(std::chrono::duration_cast<Timestamp::duration>(std::chrono::nanoseconds(nanos)));
+}
+
+// Alignment used to keep independently written state on separate cache lines
+constexpr size_t kCacheLineSize = 64;
+
+// Spin-wait hint for busy loops
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Compile-time indicator slots carried inline with each tick
+enum class IndicatorId : uint8_t {
+    SMA_5,
+    SMA_10,
+    SMA_20,
+    SMA_50,
+    EMA_10,
+    EMA_20,
+    RSI,
+    MACD,
+    MACD_SIGNAL,
+    MACD_HIST,
+    BB_UPPER,
+    BB_LOWER,
+    ATR,
+    OBV,
+    VWAP,
+    COUNT
+};
+
+constexpr size_t kIndicatorCount = static_cast<size_t>(IndicatorId::COUNT);
+
+// Names as produced by data_service (e.g. DataProcessor column names)
+constexpr std::array<const char*, kIndicatorCount> kIndicatorNames = {
+    "sma_5", "sma_10", "sma_20", "sma_50", "ema_10", "ema_20", "rsi",
+    "macd", "macd_signal", "macd_hist", "bb_upper", "bb_lower", "atr",
+    "obv", "vwap"
+};
+
+// Returns IndicatorId::COUNT for names without a fixed slot
+inline IndicatorId indicatorFromName(const std::string& name) {
+    for (size_t i = 0; i < kIndicatorCount; ++i) {
+        if (name == kIndicatorNames[i]) {
+            return static_cast<IndicatorId>(i);
+        }
+    }
+    return IndicatorId::COUNT;
+}
+
 // Market Data Structure
+// Fixed-size and trivially copyable so ticks move through queues and
+// strategies without heap allocation.
 struct MarketData {
-    std::string symbol;
-    double last_price;
-    double open;
-    double high;
-    double low;
-    double volume;
-    Timestamp timestamp;
-    
-    // Optional extended data
-    std::map<std::string, double> indicators;  // Technical indicators
+    SymbolId symbol_id = kInvalidSymbol;
+    uint32_t indicator_mask = 0;  // Bit i set when indicators[i] is valid
+    double last_price = 0.0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double volume = 0.0;
+    Timestamp timestamp{};
+    std::array<double, kIndicatorCount> indicators{};  // Technical indicators
+
+    bool hasIndicator(IndicatorId id) const {
+        return (indicator_mask >> static_cast<size_t>(id)) & 1u;
+    }
+
+    double getIndicator(IndicatorId id) const {
+        return indicators[static_cast<size_t>(id)];
+    }
+
+    void setIndicator(IndicatorId id, double value) {
+        indicators[static_cast<size_t>(id)] = value;
+        indicator_mask |= 1u << static_cast<size_t>(id);
+    }
+};
+
+static_assert(std::is_trivially_copyable<MarketData>::value,
+              "MarketData must stay trivially copyable");
+static_assert(kIndicatorCount <= 32, "indicator_mask holds at most 32 indicators");
+
+// Optional side channel for data without a fixed slot in MarketData
+struct MarketDataExtras {
+    std::map<std::string, double> indicators;    // Indicators outside IndicatorId
     std::map<std::string, double> fundamentals;  // Fundamental data
 };
 
@@ -47,113 +136,102 @@ enum class OrderStatus {
     REJECTED
 };
 
+// FILLED, CANCELLED and REJECTED are final
+inline bool isTerminal(OrderStatus status) {
+    return status == OrderStatus::FILLED || status == OrderStatus::CANCELLED ||
+           status == OrderStatus::REJECTED;
+}
+
+// Order identifier, unique within the process
+using OrderId = uint64_t;
+constexpr OrderId kInvalidOrderId = 0;
+
+// Allocates order IDs; a single relaxed atomic increment
+inline OrderId nextOrderId() {
+    static std::atomic<OrderId> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// String form for logging and serialization only
+inline std::string formatOrderId(OrderId id) {
+    return "ORD" + std::to_string(id);
+}
+
 // Order Class
 class Order {
 public:
+    Order(SymbolId symbol, OrderSide side, OrderType type, double quantity)
+        : order_id_(nextOrderId()), symbol_(symbol), side_(side), type_(type), quantity_(quantity) {
+    }
+
     Order(const std::string& symbol, OrderSide side, OrderType type, double quantity)
-        : symbol_(symbol), side_(side), type_(type), quantity_(quantity) {
-        order_id_ = generateOrderId();
+        : Order(internSymbol(symbol), side, type, quantity) {
+    }
+
+    // Empty placeholder, e.g. in a default-constructed OrderUpdate. Leaves
+    // the timestamps zero so building one does not read the clock.
+    Order()
+        : order_id_(kInvalidOrderId), symbol_(kInvalidSymbol), side_(OrderSide::BUY),
+          type_(OrderType::MARKET), quantity_(0.0), create_time_(), update_time_() {
     }
 
     // Getters
-    std::string getOrderId() const { return order_id_; }
-    std::string getSymbol() const { return symbol_; }
+    OrderId getOrderId() const { return order_id_; }
+    SymbolId getSymbol() const { return symbol_; }
     OrderSide getSide() const { return side_; }
     OrderType getType() const { return type_; }
     double getQuantity() const { return quantity_; }
     double getPrice() const { return price_; }
     OrderStatus getStatus() const { return status_; }
+    double getFilledQuantity() const { return filled_quantity_; }
+    double getRemainingQuantity() const { return quantity_ - filled_quantity_; }
+    double getAverageFillPrice() const { return average_fill_price_; }
+    double getStopPrice() const { return stop_price_; }
+    Timestamp getCreateTime() const { return create_time_; }
+    Timestamp getUpdateTime() const { return update_time_; }
+    bool isActive() const { return !isTerminal(status_); }
 
     // Setters
     void setPrice(double price) { price_ = price; }
     void setStatus(OrderStatus status) { status_ = status; }
     void setFilledQuantity(double qty) { filled_quantity_ = qty; }
-
-private:
-    static std::string generateOrderId() {
-        static int counter = 0;
-        return "ORD" + std::to_string(++counter);
+    void setQuantity(double quantity) { quantity_ = quantity; }
+    void setStopPrice(double price) { stop_price_ = price; }
+    void setUpdateTime(Timestamp time) { update_time_ = time; }
+
+    // Records an execution and moves to PARTIALLY_FILLED or FILLED
+    void applyFill(double quantity, double price) {
+        double filled = filled_quantity_ + quantity;
+        average_fill_price_ = (average_fill_price_ * filled_quantity_ + price * quantity) / filled;
+        filled_quantity_ = filled;
+        status_ = filled_quantity_ >= quantity_ ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED;
+        update_time_ = std::chrono::system_clock::now();
     }
 
-    std::string order_id_;
-    std::string symbol_;
+private:
+    OrderId order_id_;
+    SymbolId symbol_;
     OrderSide side_;
     OrderType type_;
     double quantity_;
     double price_ = 0.0;
+    double stop_price_ = 0.0;
     double filled_quantity_ = 0.0;
+    double average_fill_price_ = 0.0;
     OrderStatus status_ = OrderStatus::PENDING;
     Timestamp create_time_ = std::chrono::system_clock::now();
     Timestamp update_time_ = create_time_;
 };
 
-// Position Class
-class Position {
-public:
-    Position(const std::string& symbol) : symbol_(symbol) {}
-
-    void updatePosition(double quantity, double price) {
-        quantity_ += quantity;
-        if (quantity_ != 0) {
-            average_price_ = (average_price_ * (quantity_ - quantity) + price * quantity) / quantity_;
-        }
-    }
-
-    double getQuantity() const { return quantity_; }
-    double getAveragePrice() const { return average_price_; }
-    double getMarketValue(double current_price) const { return quantity_ * current_price; }
-    double getUnrealizedPnL(double current_price) const {
-        return quantity_ * (current_price - average_price_);
-    }
-
-private:
-    std::string symbol_;
-    double quantity_ = 0.0;
-    double average_price_ = 0.0;
+// Order state change delivered to the engine: a snapshot of the order
+// after the event, plus the execution that caused it, if any
+struct OrderUpdate {
+    Order order;
+    double fill_quantity = 0.0;  // 0 for cancels, rejects and replaces
+    double fill_price = 0.0;
 };
 
-// Portfolio Class
-class Portfolio {
-public:
-    void updatePosition(const std::string& symbol, double quantity, double price) {
-        if (positions_.find(symbol) == positions_.end()) {
-            positions_[symbol] = std::make_shared<Position>(symbol);
-        }
-        positions_[symbol]->updatePosition(quantity, price);
-    }
-
-    double getTotalValue(const std::map<std::string, double>& current_prices) const {
-        double total = cash_;
-        for (const auto& [symbol, position] : positions_) {
-            if (current_prices.find(symbol) != current_prices.end()) {
-                total += position->getMarketValue(current_prices.at(symbol));
-            }
-        }
-        return total;
-    }
-
-    double getCash() const { return cash_; }
-    void updateCash(double amount) { cash_ += amount; }
-    
-    std::shared_ptr<Position> getPosition(const std::string& symbol) const {
-        auto it = positions_.find(symbol);
-        return (it != positions_.end()) ? it->second : nullptr;
-    }
-
-    double getTotalExposure() const { return total_exposure_; }
-    double getDrawdown() const { return drawdown_; }
-    double getLeverage() const { return leverage_; }
-    double getDailyPnL() const { return daily_pnl_; }
-    double getConcentration() const { return concentration_; }
-
-private:
-    double cash_ = 1000000.0;  // Initial capital 1 million
-    std::map<std::string, std::shared_ptr<Position>> positions_;
-    double total_exposure_ = 0.0;
-    double drawdown_ = 0.0;
-    double leverage_ = 1.0;
-    double daily_pnl_ = 0.0;
-    double concentration_ = 0.0;
-};
+static_assert(std::is_trivially_copyable<OrderUpdate>::value,
+              "OrderUpdate must stay trivially copyable");
 
 }
\ No newline at end of file
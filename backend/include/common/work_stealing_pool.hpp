@@ -0,0 +1,161 @@
+#pragma once
+#include "common/types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trading {
+
+// Fixed-size pool where every worker has its own task deque. A worker
+// takes its newest task first and, when its deque is empty, steals the
+// oldest task of another worker, so uneven tasks (e.g. backtests of very
+// different length) keep every core busy without a shared queue. Each
+// deque has its own lock, which is cheap next to tasks of microseconds
+// or more.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // 0 threads: one per hardware thread
+    explicit WorkStealingPool(size_t threads = 0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back(&WorkStealingPool::run, this, i);
+        }
+    }
+
+    // Finishes queued tasks before returning
+    ~WorkStealingPool() {
+        wait(false);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Any thread. From a worker the task goes to that worker's own deque.
+    void submit(Task task) {
+        size_t index = (current_pool_ == this) ? current_worker_
+                                               : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+            workers_[index]->tasks.push_back(std::move(task));
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    // Blocks until every submitted task has run. Rethrows the first
+    // exception a task threw since the last wait().
+    void wait() { wait(true); }
+
+    size_t size() const { return workers_.size(); }
+
+private:
+    struct alignas(kCacheLineSize) Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void wait(bool rethrow) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+        if (rethrow && error_) {
+            std::exception_ptr error = std::exchange(error_, nullptr);
+            std::rethrow_exception(error);
+        }
+    }
+
+    bool take(size_t self, Task& task) {
+        {
+            Worker& own = *workers_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < workers_.size(); ++offset) {
+            Worker& victim = *workers_[(self + offset) % workers_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(size_t self) {
+        current_pool_ = this;
+        current_worker_ = self;
+        Task task;
+        for (;;) {
+            if (take(self, task)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (!error_) {
+                        error_ = std::current_exception();
+                    }
+                }
+                task = nullptr;
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    idle_.notify_all();
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] {
+                return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_{0};     // Round-robin target for outside submits
+    std::atomic<size_t> queued_{0};   // In deques, not yet taken
+    std::atomic<size_t> pending_{0};  // Submitted, not yet finished
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+
+    static inline thread_local WorkStealingPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_worker_ = 0;
+};
+
+} // namespace trading
@@ -2,9 +2,9 @@
 #include <string>
 #include <memory>
 #include <vector>
-#include <pybind11/pybind11.h>
-#include <pybind11/numpy.h>
+#include <functional>
 #include "common/types.hpp"
+#include "historical_stream.hpp"
 
 namespace trading {
 
@@ -13,16 +13,34 @@ public:
     DataLoader();
     ~DataLoader();
 
-    // Load data from Python data service
-    MarketData loadMarketData(const std::string& symbol);
-    
-    // Load historical data
+    // Load data from Python data service. Indicators without a fixed
+    // IndicatorId slot and fundamentals go to extras when provided.
+    MarketData loadMarketData(const std::string& symbol, MarketDataExtras* extras = nullptr);
+
+    // Load the latest quote for every symbol in one Python call. Only
+    // symbols with data are written to out; the GIL is released while
+    // the NumPy buffer is converted.
+    void loadMarketDataBatch(const std::vector<SymbolId>& symbols, std::vector<MarketData>& out);
+
+    // Load historical data from the Python data service. The whole range
+    // is held in memory; use openHistoricalStream for long tick ranges.
     std::vector<MarketData> loadHistoricalData(
         const std::string& symbol,
         const Timestamp& start,
         const Timestamp& end
     );
-    
+
+    // Stream symbols' ticks in [start, end] from the tick store at path,
+    // in timestamp order, without holding the range in memory. Reads only
+    // the store; no Python call is made.
+    static std::unique_ptr<HistoricalStream> openHistoricalStream(
+        const std::string& path,
+        const std::vector<std::string>& symbols,
+        const Timestamp& start,
+        const Timestamp& end,
+        const HistoricalStream::Options& options
+    );
+
     // Subscribe to real-time data
     void subscribeToRealTimeData(
         const std::string& symbol,
@@ -30,8 +48,8 @@ public:
     );
 
 private:
-    py::module data_service_;  // Python module
-    py::object fetcher_;       // Python data fetcher instance
+    class Impl;  // Hides the Python interface
+    std::unique_ptr<Impl> pimpl_;
 };
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
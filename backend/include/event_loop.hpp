@@ -0,0 +1,79 @@
+#pragma once
+#include "common/types.hpp"
+#include "common/ring_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+
+namespace trading {
+
+// Event delivered to the engine loop. The payload is a union, so a queue
+// slot is as large as the bigger of the two rather than both; read only
+// the member type selects.
+struct EngineEvent {
+    enum class Type {
+        MARKET_DATA,
+        ORDER_UPDATE,
+        WAKEUP
+    };
+
+    Type type = Type::WAKEUP;
+    union {
+        MarketData market_data;
+        OrderUpdate order_update;
+    };
+
+    EngineEvent() : market_data() {}
+    explicit EngineEvent(const MarketData& data) : type(Type::MARKET_DATA), market_data(data) {}
+    explicit EngineEvent(const OrderUpdate& update) : type(Type::ORDER_UPDATE), order_update(update) {}
+};
+
+static_assert(std::is_trivially_copyable<EngineEvent>::value,
+              "EngineEvent must stay trivially copyable");
+
+// Event-driven main loop. Producers (market data feeds, the order executor)
+// post events and wake the loop immediately instead of the loop polling.
+class EventLoop {
+public:
+    struct Options {
+        bool busy_spin = false;  // Spin on an empty queue instead of blocking
+        int cpu_core = -1;       // Pin the loop thread to this core (-1 = no pinning)
+        std::chrono::milliseconds housekeeping_interval{100};  // Periodic tasks
+        size_t queue_capacity = 16384;  // Pending events before producers back off
+    };
+
+    using EventHandler = std::function<void(const EngineEvent&)>;
+    using HousekeepingHandler = std::function<void()>;
+
+    EventLoop();
+    explicit EventLoop(const Options& options);
+
+    // Thread-safe, callable from any producer thread. Lock-free; yields
+    // while the queue is full rather than dropping events.
+    void post(const MarketData& data);
+    void post(const OrderUpdate& update);
+    void post(EngineEvent event);
+
+    // Runs on the calling thread until stop() is called. Returns at once if
+    // stop() was called before run().
+    void run(const EventHandler& on_event, const HousekeepingHandler& on_housekeeping);
+
+    // Sets an atomic flag and wakes the loop with a futex call, so it is
+    // safe from a signal handler
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    const Options& getOptions() const { return options_; }
+
+private:
+    void pinToCore();
+
+    Options options_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stop_requested_;
+    MpscQueue<EngineEvent> queue_;
+    QueueWaiter waiter_;
+};
+
+} // namespace trading
@@ -0,0 +1,77 @@
+#pragma once
+#include "common/types.hpp"
+#include "price_table.hpp"
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace trading {
+
+// What a venue reports back about an order
+struct ExecutionReport {
+    enum class Type {
+        FILL,
+        CANCELLED,
+        REJECTED,
+        REPLACED
+    };
+
+    Type type = Type::FILL;
+    OrderId order_id = kInvalidOrderId;
+    double quantity = 0.0;  // FILL: executed quantity; REPLACED: new order quantity
+    double price = 0.0;     // FILL: execution price; REPLACED: new limit price
+    Timestamp timestamp{};
+};
+
+// Where OrderExecutor routes orders. All calls, and all reports, happen on
+// the executor thread; a venue may report synchronously from inside a call
+// or later from poll().
+class ExecutionVenue {
+public:
+    using ReportSink = std::function<void(const ExecutionReport&)>;
+
+    virtual ~ExecutionVenue() = default;
+
+    virtual void submit(const Order& order) = 0;
+    virtual void cancel(OrderId order_id) = 0;
+    // New total quantity (not below the filled quantity) and limit price
+    virtual void replace(OrderId order_id, double quantity, double price) = 0;
+    // Delivers reports that became due since the last call
+    virtual void poll() {}
+    // False while reports are still due, so the executor keeps polling
+    // instead of sleeping
+    virtual bool idle() const { return true; }
+    virtual std::string describe() const = 0;
+
+    void setReportSink(ReportSink sink) { sink_ = std::move(sink); }
+
+protected:
+    void report(const ExecutionReport& report) {
+        if (sink_) {
+            sink_(report);
+        }
+    }
+
+private:
+    ReportSink sink_;
+};
+
+// Fills marketable orders in full at the last traded price. The rest are
+// re-tested against the price table on every poll() and fill once the
+// price reaches them, unless cancelled first. Stand-in for a real gateway.
+class ImmediateFillVenue : public ExecutionVenue {
+public:
+    explicit ImmediateFillVenue(const PriceTable* prices = nullptr) : prices_(prices) {}
+
+    void submit(const Order& order) override;
+    void cancel(OrderId order_id) override;
+    void replace(OrderId order_id, double quantity, double price) override;
+    void poll() override;
+    std::string describe() const override { return "immediate-fill"; }
+
+private:
+    const PriceTable* prices_;
+    std::unordered_map<OrderId, Order> resting_;
+};
+
+} // namespace trading
@@ -0,0 +1,197 @@
+#pragma once
+#include "common/types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+// Fixed 64-byte record used by binary replay files
+struct TickRecord {
+    int64_t timestamp_ns;
+    char symbol[16];  // NUL-padded
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+};
+
+static_assert(sizeof(TickRecord) == 64, "TickRecord is a fixed wire format");
+
+// Native market data source. Implementations decode straight into
+// MarketData and never touch the Python interpreter.
+class MarketDataSource {
+public:
+    virtual ~MarketDataSource() = default;
+    virtual void open() = 0;
+    // Decodes the next tick; returns false at end of stream
+    virtual bool next(MarketData& tick) = 0;
+    virtual void close() = 0;
+    virtual std::string describe() const = 0;
+    // Unblocks a pending next() from another thread
+    virtual void interrupt() {}
+};
+
+// Caches symbol interning so sources take the SymbolTable lock once per symbol
+class SymbolCache {
+public:
+    SymbolId resolve(const char* name, size_t length);
+
+private:
+    std::unordered_map<std::string, SymbolId> ids_;
+};
+
+// Replays "timestamp_ns,symbol,open,high,low,close,volume" lines. A header
+// line is skipped, and so are lines longer than kMaxLineLength rather than
+// parsing a truncated prefix.
+class CsvReplaySource : public MarketDataSource {
+public:
+    explicit CsvReplaySource(std::string path);
+    ~CsvReplaySource() override;
+
+    void open() override;
+    bool next(MarketData& tick) override;
+    void close() override;
+    std::string describe() const override { return "csv:" + path_; }
+
+    static constexpr size_t kMaxLineLength = 510;  // Excluding the newline
+
+    // Parses one CSV tick line; returns false if it is malformed
+    static bool parseLine(const char* line, SymbolCache& symbols, MarketData& tick);
+
+private:
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::vector<char> line_;
+    SymbolCache symbols_;
+};
+
+// Replays a file of TickRecord, read in large blocks
+class BinaryReplaySource : public MarketDataSource {
+public:
+    explicit BinaryReplaySource(std::string path, size_t block_records = 4096);
+    ~BinaryReplaySource() override;
+
+    void open() override;
+    bool next(MarketData& tick) override;
+    void close() override;
+    std::string describe() const override { return "binary:" + path_; }
+
+private:
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::vector<TickRecord> block_;
+    size_t block_size_ = 0;
+    size_t block_pos_ = 0;
+    SymbolCache symbols_;
+};
+
+// Writes TickRecord files for BinaryReplaySource
+class BinaryTickWriter {
+public:
+    explicit BinaryTickWriter(const std::string& path);
+    ~BinaryTickWriter();
+
+    void write(const MarketData& tick);
+    void close();
+
+private:
+    std::FILE* file_ = nullptr;
+};
+
+// Reads CSV tick lines from a TCP connection
+class TcpFeedSource : public MarketDataSource {
+public:
+    TcpFeedSource(std::string host, uint16_t port);
+    ~TcpFeedSource() override;
+
+    void open() override;
+    bool next(MarketData& tick) override;
+    void close() override;
+    std::string describe() const override;
+    void interrupt() override;
+
+private:
+    class Connection;
+    std::string host_;
+    uint16_t port_;
+    std::unique_ptr<Connection> connection_;
+    SymbolCache symbols_;
+};
+
+// Local stand-in for an exchange feed: serves ticks from any source as CSV
+// lines to one TCP client at a time.
+class FeedReplayServer {
+public:
+    FeedReplayServer(std::unique_ptr<MarketDataSource> source, uint16_t port);
+    ~FeedReplayServer();
+
+    void start();
+    void stop();
+    uint16_t getPort() const { return port_; }
+
+private:
+    class Acceptor;
+    void serveLoop();
+
+    std::unique_ptr<MarketDataSource> source_;
+    uint16_t port_;
+    std::unique_ptr<Acceptor> acceptor_;
+    std::atomic<bool> running_;
+    std::mutex client_mutex_;
+    int client_fd_ = -1;  // Connected client, shut down by stop()
+    std::thread thread_;
+};
+
+struct FeedConfig {
+    std::string source = "python";  // python, csv, binary or tcp
+    std::string path;
+    std::string host = "127.0.0.1";
+    uint16_t port = 9100;
+    bool pace = false;    // Replay files at their recorded timestamps
+    double speed = 1.0;   // Replay speed multiplier when pacing
+};
+
+// Builds the native source for config; throws for "python" or unknown types
+std::unique_ptr<MarketDataSource> makeMarketDataSource(const FeedConfig& config);
+
+// Runs a MarketDataSource on a dedicated I/O thread and hands each decoded
+// tick to the callback (typically EventLoop::post).
+class FeedHandler {
+public:
+    using TickCallback = std::function<void(const MarketData&)>;
+
+    FeedHandler(std::unique_ptr<MarketDataSource> source, TickCallback callback,
+                bool pace = false, double speed = 1.0);
+    ~FeedHandler();
+
+    void start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    uint64_t getTicksDecoded() const { return ticks_decoded_.load(std::memory_order_relaxed); }
+
+private:
+    void ioLoop();
+
+    std::unique_ptr<MarketDataSource> source_;
+    TickCallback callback_;
+    bool pace_;
+    double speed_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> ticks_decoded_;
+    // Paced replay sleeps on this so stop() can cut an overnight gap short
+    std::mutex pace_mutex_;
+    std::condition_variable pace_wake_;
+    std::thread io_thread_;
+};
+
+} // namespace trading
@@ -0,0 +1,99 @@
+#pragma once
+#include "common/span.hpp"
+#include "common/types.hpp"
+#include "tick_store.hpp"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace trading {
+
+// Streams ticks of a TickStore range in fixed-size batches, merged across
+// symbols in timestamp order. Ties go to the symbol listed first.
+//
+// A background thread decodes chunks and fills batches ahead of the
+// consumer. It stops when every batch slot is full. Memory is therefore
+// bounded by the batch slots, plus one decoded chunk (a symbol-day) per
+// symbol, whatever the length of the range.
+//
+// Single consumer: next() must be called from one thread at a time.
+class HistoricalStream {
+public:
+    struct Options {
+        size_t batch_size = 16384;  // Ticks per batch
+        size_t prefetch = 2;        // Batches decoded ahead of the consumer
+    };
+
+    // Opens the store at path. Symbols the store does not contain are
+    // skipped with a warning. Throws std::runtime_error if the store cannot
+    // be opened and std::invalid_argument if batch_size is zero.
+    HistoricalStream(const std::string& path, std::vector<SymbolId> symbols, Timestamp start, Timestamp end,
+                     const Options& options);
+    // Stops the prefetch thread; batches not yet read are dropped
+    ~HistoricalStream();
+
+    HistoricalStream(const HistoricalStream&) = delete;
+    HistoricalStream& operator=(const HistoricalStream&) = delete;
+
+    // Next batch in time order, or an empty span once the range is
+    // exhausted. Valid until the following call. Errors on the prefetch
+    // thread are rethrown here, after the batches decoded before them.
+    Span<const MarketData> next();
+
+    const std::vector<SymbolId>& symbols() const { return symbols_; }
+
+    // Memory held by the batch slots
+    size_t bufferBytes() const { return slots_.size() * options_.batch_size * sizeof(MarketData); }
+
+private:
+    void produce();
+    void fill(std::vector<MarketData>& batch);
+
+    // One symbol's position in the range
+    struct Cursor {
+        size_t order;  // Position in symbols_, breaks timestamp ties
+        Span<const tick_store::ChunkEntry> entries;
+        size_t next_entry = 0;
+        TickStore::Buffer buffer;
+        TickStore::Chunk chunk;
+        size_t row = 0;
+
+        int64_t time() const { return chunk.timestamps[row]; }
+    };
+
+    // Loads the cursor's next non-empty chunk; false when none is left
+    bool advance(Cursor& cursor) const;
+    // Heap order: true if a comes after b
+    static bool later(const Cursor* a, const Cursor* b);
+
+    TickStore store_;
+    std::vector<SymbolId> symbols_;
+    Timestamp start_;
+    Timestamp end_;
+    Options options_;
+
+    // Producer-only state
+    std::vector<Cursor> cursors_;
+    std::vector<Cursor*> heap_;  // Min-heap on (time, order)
+
+    // Batch n is decoded into slots_[n % slots_.size()]. Batches
+    // [released_, published_) are queued or held by the consumer, so the
+    // producer waits while all slots are in that range.
+    std::vector<std::vector<MarketData>> slots_;
+    std::mutex mutex_;
+    std::condition_variable ready_;  // Batch published or producer done
+    std::condition_variable space_;  // Batch released or stop requested
+    size_t published_ = 0;
+    size_t taken_ = 0;
+    size_t released_ = 0;
+    bool holding_ = false;  // Consumer still reads batch taken_ - 1
+    bool finished_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread producer_;
+};
+
+} // namespace trading
@@ -0,0 +1,129 @@
+#pragma once
+#include "common/types.hpp"
+#include "execution_venue.hpp"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+// Where a new resting order is assumed to join the queue at its price,
+// relative to liquidity from outside the book (see onTrade)
+enum class QueuePosition {
+    FRONT,        // Fills from the first outside trade at its price
+    BEHIND,       // Behind Options::queue_ahead of outside quantity
+    THROUGH_ONLY  // Fills only when outside trades go through its price
+};
+
+// Deterministic price-time priority limit order book for every symbol.
+// Handles all four order types: market orders take liquidity and cancel
+// any remainder, limits rest, stops wait for the last trade to reach the
+// stop price and then act as a market or limit order.
+//
+// Besides orders matching each other, the book can stand for a real
+// market: marketable orders fill against outside liquidity at the last
+// trade price, and outside trades reported through onTrade() fill
+// resting orders subject to the queue position model.
+//
+// Not thread-safe. Reports are emitted synchronously from the call that
+// caused them.
+class MatchingEngine {
+public:
+    struct Options {
+        double tick_size = 0.01;
+        // False for a closed book where only submitted orders trade
+        bool outside_liquidity = true;
+        QueuePosition queue_position = QueuePosition::FRONT;
+        double queue_ahead = 0.0;  // QueuePosition::BEHIND only
+    };
+
+    using ReportSink = std::function<void(const ExecutionReport&)>;
+
+    MatchingEngine();
+    explicit MatchingEngine(const Options& options);
+
+    void setReportSink(ReportSink sink) { sink_ = std::move(sink); }
+
+    // Invalid orders are reported REJECTED
+    void submit(const Order& order, Timestamp now);
+    // False if the order is not open
+    bool cancel(OrderId order_id, Timestamp now);
+    // New total quantity and limit price. Keeps time priority only when
+    // the price is unchanged and the quantity does not grow.
+    bool replace(OrderId order_id, double quantity, double price, Timestamp now);
+    // A trade outside the book: moves the last price, fills the resting
+    // orders it reaches and triggers stops
+    void onTrade(SymbolId symbol, double price, double quantity, Timestamp now);
+
+    // 0.0 when there is no such price
+    double getBestBid(SymbolId symbol) const;
+    double getBestAsk(SymbolId symbol) const;
+    double getLastPrice(SymbolId symbol) const;
+    size_t getOpenOrderCount() const { return index_.size(); }
+    bool hasOpenOrders(SymbolId symbol) const;
+
+private:
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    struct Node {
+        OrderId id = kInvalidOrderId;
+        SymbolId symbol = kInvalidSymbol;
+        OrderSide side = OrderSide::BUY;
+        OrderType type = OrderType::MARKET;
+        int64_t limit = 0;  // Ticks; INT64_MAX / INT64_MIN for market buys / sells
+        int64_t stop = 0;
+        double quantity = 0.0;
+        double filled = 0.0;
+        double ahead = 0.0;  // Outside quantity still queued in front
+        bool waiting = false;  // Untriggered stop
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+
+        double remaining() const { return quantity - filled; }
+    };
+
+    struct Level {
+        int64_t price;
+        uint32_t head;
+        uint32_t tail;
+    };
+
+    struct Book {
+        // Best price at the back, so the common case touches only the end
+        std::vector<Level> bids;  // Ascending
+        std::vector<Level> asks;  // Descending
+        std::multimap<int64_t, uint32_t> buy_stops;  // Trigger at or above
+        std::multimap<int64_t, uint32_t, std::greater<int64_t>> sell_stops;  // At or below
+        int64_t last = 0;  // 0 before the first trade
+        size_t open = 0;
+    };
+
+    Book& bookFor(SymbolId symbol);
+    const Book* findBook(SymbolId symbol) const;
+    int64_t toTicks(double price) const;
+    double toPrice(int64_t ticks) const { return static_cast<double>(ticks) * options_.tick_size; }
+
+    uint32_t allocate();
+    void release(Book& book, uint32_t index);
+    // Matches an active order, then rests or cancels what is left
+    void execute(Book& book, uint32_t index, Timestamp now);
+    void rest(Book& book, uint32_t index);
+    void unlink(Book& book, uint32_t index);
+    void removeStop(Book& book, uint32_t index);
+    void fill(uint32_t index, double quantity, int64_t price, Timestamp now);
+    // Fills resting orders on one side reached by an outside trade
+    void fillResting(Book& book, OrderSide side, int64_t price, double quantity, Timestamp now);
+    void triggerStops(Book& book, Timestamp now);
+    void emit(ExecutionReport::Type type, OrderId order_id, double quantity, double price, Timestamp now);
+
+    Options options_;
+    ReportSink sink_;
+    std::vector<Book> books_;  // Indexed by SymbolId
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_;
+    std::unordered_map<OrderId, uint32_t> index_;
+};
+
+} // namespace trading
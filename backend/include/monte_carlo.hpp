@@ -0,0 +1,58 @@
+#pragma once
+#include "var_engine.hpp"
+#include "common/aligned_allocator.hpp"
+#include <chrono>
+#include <cstdint>
+
+namespace trading {
+
+struct MonteCarloResult {
+    double var = 0.0;
+    double expected_shortfall = 0.0;
+    size_t scenarios = 0;  // 0 when the model had no assets
+};
+
+// Scenario-based tail risk by filtered historical simulation. Each
+// asset's return window is passed through an EWMA volatility filter and
+// row t is rescaled by sigma_now / sigma_t. Past shocks therefore keep
+// their joint shape, skew and fat tails, but are sized to the current
+// volatility. A scenario sums `horizon` filtered rows, drawn with
+// replacement from a Philox stream keyed by (seed, scenario index), so
+// each scenario is the same no matter which thread evaluates it. Unlike
+// the parametric VaR this is not Gaussian, and unlike plain historical
+// VaR it follows volatility regimes and multi-interval horizons.
+// Scenarios are split into fixed-size blocks that worker threads claim
+// from an atomic counter.
+class MonteCarloEngine {
+public:
+    struct Options {
+        size_t scenarios = 1000000;
+        size_t threads = 0;          // 0 = hardware concurrency
+        size_t block_size = 4096;    // Scenarios per work item
+        double confidence = 0.95;
+        size_t horizon = 1;          // Sampling intervals per scenario
+        double ewma_decay = 0.94;    // Volatility filter, RiskMetrics daily value
+        uint64_t seed = 0x5eed;
+        std::chrono::milliseconds run_interval{60000};  // Engine's re-run cadence
+    };
+
+    MonteCarloEngine();
+    explicit MonteCarloEngine(const Options& options);
+
+    // Blocking; spreads the run across the configured threads. Needs at
+    // least two return samples, otherwise no scenarios are run.
+    MonteCarloResult run(const MarketModel& model);
+
+    const Options& getOptions() const { return options_; }
+
+private:
+    void filterRows(const MarketModel& model);
+    void simulateBlock(size_t block, size_t samples, const double* row_pnl);
+
+    Options options_;
+    AlignedVector<double> row_pnl_;   // Book P&L of each filtered window row
+    AlignedVector<double> variance_;  // EWMA variance forecast per row, scratch
+    AlignedVector<double> pnl_;       // One P&L per scenario
+};
+
+} // namespace trading
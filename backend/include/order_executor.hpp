@@ -1,32 +1,110 @@
 #pragma once
 #include "common/types.hpp"
-#include <queue>
+#include "common/ring_queue.hpp"
+#include "common/span.hpp"
+#include "execution_venue.hpp"
+#include "order_pool.hpp"
+#include "order_table.hpp"
+#include "order_throttle.hpp"
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <thread>
 #include <atomic>
-#include <condition_variable>
+#include <vector>
 
 namespace trading {
 
+// Request from any thread to the execution thread
+struct OrderCommand {
+    enum class Type : uint8_t {
+        NEW,
+        CANCEL,
+        REPLACE
+    };
+
+    Type type = Type::NEW;
+    Order* order = nullptr;        // NEW
+    OrderId order_id = kInvalidOrderId;
+    double quantity = 0.0;         // REPLACE: new total quantity
+    double price = 0.0;            // REPLACE: new limit price
+};
+
+// Owns the order lifecycle. Orders, cancels and replaces are queued to a
+// single execution thread, which routes them to an ExecutionVenue, applies
+// the venue's reports (partial fills, cancels, replaces) to the order, and
+// hands the resulting OrderUpdates to the update handler in batches.
+//
+// Status is published in an OrderTable, so getOrderStatus() is O(1) and
+// lock-free from any thread. Orders go back to the pool once final.
 class OrderExecutor {
 public:
-    OrderExecutor();
+    struct Options {
+        size_t queue_capacity = 4096;
+        WaitStrategy wait_strategy = WaitStrategy::BLOCK;
+        bool multi_producer = true;  // false: SPSC ring for a single producer thread
+        size_t status_retention = 65536;  // Final statuses kept for lookups
+    };
+
+    using UpdateHandler = std::function<void(Span<const OrderUpdate>)>;
+
+    // Orders are returned to pool once filled, cancelled or rejected
+    explicit OrderExecutor(OrderPool& pool);
+    OrderExecutor(OrderPool& pool, const Options& options);
     ~OrderExecutor();
 
+    // Set before start()
+    void setVenue(std::unique_ptr<ExecutionVenue> venue);
+    void setUpdateHandler(UpdateHandler handler) { update_handler_ = std::move(handler); }
+    // Throttle and kill switch applied on submit; set before start()
+    void setThrottle(OrderThrottle* throttle) { throttle_ = throttle; }
+
     void start();
     void stop();
-    void submitOrder(std::shared_ptr<Order> order);
-    void cancelOrder(const std::string& order_id);
-    OrderStatus getOrderStatus(const std::string& order_id);
+    // Returns false if the order was throttled, halted or the queue is full;
+    // the caller keeps ownership in that case
+    bool submitOrder(Order* order);
+    // Asynchronous; the outcome arrives as an OrderUpdate. False if the
+    // queue is full.
+    bool cancelOrder(OrderId order_id);
+    bool replaceOrder(OrderId order_id, double quantity, double price);
+    // Latest known status; empty for unknown or long-retired orders
+    std::optional<OrderStatus> getOrderStatus(OrderId order_id) const;
+
+    // Processes everything queued and any venue reports on the calling
+    // thread. For deterministic single-threaded use (tests, backtests)
+    // instead of start().
+    void drain();
 
 private:
     void executionLoop();
-    void executeOrder(std::shared_ptr<Order> order);
+    bool processPending();
+    void handleCommand(const OrderCommand& command);
+    void handleReport(const ExecutionReport& report);
+    void retire(Order* order);
+    void flushUpdates();
+    bool tryEnqueue(const OrderCommand& command);
+    bool tryDequeue(OrderCommand& command);
+    bool queueEmpty() const;
+
+    OrderPool& pool_;
+    Options options_;
+    // Exactly one of the two rings is allocated, chosen by options_.multi_producer
+    std::unique_ptr<SpscQueue<OrderCommand>> spsc_queue_;
+    std::unique_ptr<MpscQueue<OrderCommand>> mpsc_queue_;
+    QueueWaiter waiter_;
+    OrderThrottle* throttle_ = nullptr;
+    std::unique_ptr<ExecutionVenue> venue_;
+    UpdateHandler update_handler_;
+
+    // Execution-thread state
+    OrderTable table_;
+    std::deque<OrderId> retired_;        // Final orders, oldest first
+    std::vector<OrderUpdate> updates_;   // Pending batch for update_handler_
 
-    std::queue<std::shared_ptr<Order>> order_queue_;
     std::atomic<bool> running_;
     std::thread execution_thread_;
-    std::mutex mutex_;
-    std::condition_variable cv_;
 };
 
-} // namespace trading 
\ No newline at end of file
+} // namespace trading
@@ -0,0 +1,129 @@
+#pragma once
+#include "common/types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace trading {
+
+// Preallocated storage for Order objects. acquire() and release() are
+// lock-free (a tagged Treiber stack over slot indices), so orders can be
+// created on strategy threads and returned by the execution thread without
+// touching the heap. Returned pointers stay valid until released.
+class OrderPool {
+public:
+    explicit OrderPool(size_t capacity = 65536)
+        : capacity_(static_cast<uint32_t>(capacity))
+        , slots_(new Slot[capacity])
+        , next_(new std::atomic<uint32_t>[capacity])
+        , in_use_(0) {
+        for (uint32_t i = 0; i < capacity_; ++i) {
+            next_[i].store(i + 1 < capacity_ ? i + 1 : kNil, std::memory_order_relaxed);
+        }
+        free_head_.store(pack(capacity_ ? 0 : kNil, 0), std::memory_order_relaxed);
+    }
+
+    ~OrderPool() {
+        // Destroy orders that were never released
+        for (uint32_t i = 0; i < capacity_; ++i) {
+            if (slots_[i].live) {
+                slots_[i].get()->~Order();
+            }
+        }
+    }
+
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    // Constructs an Order in a free slot; returns nullptr when exhausted
+    template <typename... Args>
+    Order* acquire(Args&&... args) {
+        uint32_t index = pop();
+        if (index == kNil) {
+            return nullptr;
+        }
+        Slot& slot = slots_[index];
+        Order* order = new (slot.storage) Order(std::forward<Args>(args)...);
+        slot.live = true;
+        in_use_.fetch_add(1, std::memory_order_relaxed);
+        return order;
+    }
+
+    void release(Order* order) {
+        if (!order) {
+            return;
+        }
+        uint32_t index = indexOf(order);
+        order->~Order();
+        slots_[index].live = false;
+        in_use_.fetch_sub(1, std::memory_order_relaxed);
+        push(index);
+    }
+
+    // Stable slot index, usable as a compact handle
+    uint32_t indexOf(const Order* order) const {
+        auto* slot = reinterpret_cast<const Slot*>(order);
+        return static_cast<uint32_t>(slot - slots_.get());
+    }
+
+    Order* get(uint32_t index) { return slots_[index].get(); }
+
+    size_t capacity() const { return capacity_; }
+    size_t inUse() const { return in_use_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    // Order storage first so an Order* converts back to its slot
+    struct alignas(kCacheLineSize) Slot {
+        alignas(Order) unsigned char storage[sizeof(Order)];
+        bool live = false;
+
+        Order* get() { return std::launder(reinterpret_cast<Order*>(storage)); }
+    };
+
+    // Head packs (tag << 32 | index); the tag defeats ABA on concurrent pops
+    static uint64_t pack(uint32_t index, uint32_t tag) {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+
+    uint32_t pop() {
+        uint64_t head = free_head_.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t index = static_cast<uint32_t>(head);
+            if (index == kNil) {
+                return kNil;
+            }
+            uint32_t next = next_[index].load(std::memory_order_relaxed);
+            uint64_t desired = pack(next, static_cast<uint32_t>(head >> 32) + 1);
+            if (free_head_.compare_exchange_weak(head, desired,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_acquire)) {
+                return index;
+            }
+        }
+    }
+
+    void push(uint32_t index) {
+        uint64_t head = free_head_.load(std::memory_order_relaxed);
+        for (;;) {
+            next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            uint64_t desired = pack(index, static_cast<uint32_t>(head >> 32) + 1);
+            if (free_head_.compare_exchange_weak(head, desired,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    const uint32_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;
+    alignas(kCacheLineSize) std::atomic<uint64_t> free_head_;
+    std::atomic<size_t> in_use_;
+};
+
+} // namespace trading
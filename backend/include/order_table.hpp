@@ -0,0 +1,170 @@
+#pragma once
+#include "common/types.hpp"
+#include "common/ring_queue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace trading {
+
+// Fixed-capacity open-addressing map from OrderId to order and status
+// (linear probing, Fibonacci hashing). One writer thread inserts, updates
+// and erases; any thread can read a status lock-free. Erase uses backward
+// shift instead of tombstones, bracketed by a sequence counter so a
+// reader racing a shift retries instead of missing an entry.
+class OrderTable {
+public:
+    explicit OrderTable(size_t capacity)
+        : mask_(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity) - 1),
+          shift_(64 - log2(mask_ + 1)),
+          slots_(new Slot[mask_ + 1]) {}
+
+    // Writer only. Fails when the table is more than half full.
+    bool insert(OrderId id, Order* order, OrderStatus status) {
+        if (size_ * 2 >= mask_ + 1) {
+            return false;
+        }
+        size_t index = home(id);
+        while (slots_[index].key.load(std::memory_order_relaxed) != kEmpty) {
+            index = (index + 1) & mask_;
+        }
+        Slot& slot = slots_[index];
+        slot.order = order;
+        slot.status.store(static_cast<uint8_t>(status), std::memory_order_relaxed);
+        slot.key.store(id, std::memory_order_release);
+        ++size_;
+        return true;
+    }
+
+    // Writer only
+    Order* find(OrderId id) const {
+        const Slot* slot = locate(id);
+        return slot ? slot->order : nullptr;
+    }
+
+    // Writer only. The entry keeps its status after its order is detached.
+    void setStatus(OrderId id, OrderStatus status) {
+        if (Slot* slot = locate(id)) {
+            slot->status.store(static_cast<uint8_t>(status), std::memory_order_release);
+        }
+    }
+
+    void detach(OrderId id) {
+        if (Slot* slot = locate(id)) {
+            slot->order = nullptr;
+        }
+    }
+
+    // Writer only
+    bool erase(OrderId id) {
+        Slot* slot = locate(id);
+        if (!slot) {
+            return false;
+        }
+        size_t hole = static_cast<size_t>(slot - slots_.get());
+
+        uint64_t version = version_.load(std::memory_order_relaxed);
+        version_.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // Pull later entries of the probe run back over the hole
+        for (size_t next = (hole + 1) & mask_; ; next = (next + 1) & mask_) {
+            uint64_t key = slots_[next].key.load(std::memory_order_relaxed);
+            if (key == kEmpty) {
+                break;
+            }
+            size_t desired = home(key);
+            bool stays = hole <= next ? (desired > hole && desired <= next)
+                                      : (desired > hole || desired <= next);
+            if (!stays) {
+                slots_[hole].order = slots_[next].order;
+                slots_[hole].status.store(slots_[next].status.load(std::memory_order_relaxed),
+                                          std::memory_order_relaxed);
+                slots_[hole].key.store(key, std::memory_order_relaxed);
+                hole = next;
+            }
+        }
+        slots_[hole].key.store(kEmpty, std::memory_order_relaxed);
+        slots_[hole].order = nullptr;
+        --size_;
+
+        version_.store(version + 2, std::memory_order_release);
+        return true;
+    }
+
+    // Any thread. Returns false for unknown (or long-retired) orders.
+    bool getStatus(OrderId id, OrderStatus& status) const {
+        for (;;) {
+            uint64_t version = version_.load(std::memory_order_acquire);
+            if (version & 1) {
+                cpuRelax();
+                continue;
+            }
+            bool found = false;
+            uint8_t value = 0;
+            for (size_t index = home(id), probes = 0; probes <= mask_; index = (index + 1) & mask_, ++probes) {
+                uint64_t key = slots_[index].key.load(std::memory_order_acquire);
+                if (key == id) {
+                    value = slots_[index].status.load(std::memory_order_acquire);
+                    found = true;
+                    break;
+                }
+                if (key == kEmpty) {
+                    break;
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version_.load(std::memory_order_relaxed) == version) {
+                status = static_cast<OrderStatus>(value);
+                return found;
+            }
+        }
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static constexpr uint64_t kEmpty = kInvalidOrderId;
+
+    struct Slot {
+        std::atomic<uint64_t> key{kEmpty};
+        std::atomic<uint8_t> status{0};
+        Order* order = nullptr;  // Writer-side only
+    };
+
+    static unsigned log2(size_t value) {
+        unsigned result = 0;
+        while ((size_t(1) << result) < value) {
+            ++result;
+        }
+        return result;
+    }
+
+    size_t home(uint64_t id) const {
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> shift_) & mask_;
+    }
+
+    Slot* locate(OrderId id) const {
+        if (id == kEmpty) {
+            return nullptr;
+        }
+        for (size_t index = home(id); ; index = (index + 1) & mask_) {
+            uint64_t key = slots_[index].key.load(std::memory_order_relaxed);
+            if (key == id) {
+                return &slots_[index];
+            }
+            if (key == kEmpty) {
+                return nullptr;
+            }
+        }
+    }
+
+    const size_t mask_;
+    const unsigned shift_;
+    std::unique_ptr<Slot[]> slots_;
+    size_t size_ = 0;
+    alignas(kCacheLineSize) std::atomic<uint64_t> version_{0};
+};
+
+} // namespace trading
@@ -0,0 +1,130 @@
+#pragma once
+#include "common/types.hpp"
+#include "price_table.hpp"
+#include "risk_reject_reason.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace trading {
+
+// Lock-free token bucket in its GCRA form: the whole state is one atomic
+// "theoretical arrival time", advanced by cost / rate on each admit. A
+// bucket with rate 0 is disabled and admits everything.
+class TokenBucket {
+public:
+    // rate in units per second, burst in units; call before sharing
+    void configure(double rate_per_second, double burst) {
+        if (rate_per_second <= 0.0) {
+            nanos_per_unit_ = 0.0;
+            return;
+        }
+        nanos_per_unit_ = 1e9 / rate_per_second;
+        tolerance_ = static_cast<int64_t>(std::max(burst, 1.0) * nanos_per_unit_);
+    }
+
+    bool enabled() const { return nanos_per_unit_ > 0.0; }
+
+    bool tryAcquire(double cost, int64_t now_ns) {
+        if (!enabled()) {
+            return true;
+        }
+        int64_t increment = static_cast<int64_t>(cost * nanos_per_unit_);
+        int64_t tat = tat_.load(std::memory_order_relaxed);
+        for (;;) {
+            int64_t next = std::max(tat, now_ns) + increment;
+            if (next - now_ns > tolerance_) {
+                return false;
+            }
+            if (tat_.compare_exchange_weak(tat, next, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    // Returns tokens taken by a tryAcquire whose order was refused elsewhere
+    void refund(double cost) {
+        if (enabled()) {
+            tat_.fetch_sub(static_cast<int64_t>(cost * nanos_per_unit_), std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<int64_t> tat_{0};
+    double nanos_per_unit_ = 0.0;
+    int64_t tolerance_ = 0;
+};
+
+// Global trading halt. engage() only stores atomics, so it is safe from a
+// signal handler; the submit path pays one acquire load.
+class KillSwitch {
+public:
+    void engage(const char* reason) noexcept {
+        reason_.store(reason, std::memory_order_relaxed);
+        engaged_.store(true, std::memory_order_release);
+    }
+
+    void reset() {
+        engaged_.store(false, std::memory_order_release);
+        reason_.store("", std::memory_order_relaxed);
+    }
+
+    bool isEngaged() const { return engaged_.load(std::memory_order_acquire); }
+    const char* getReason() const { return reason_.load(std::memory_order_relaxed); }
+
+    // Engages when this file exists; checked by pollTriggerFile()
+    void setTriggerFile(const std::string& path) { trigger_file_ = path; }
+    // Returns true if the trigger file was found
+    bool pollTriggerFile();
+
+private:
+    std::atomic<bool> engaged_{false};
+    std::atomic<const char*> reason_{""};
+    std::string trigger_file_;
+};
+
+// Order-rate and notional-rate throttles, global and per symbol, plus the
+// kill switch. Checked by OrderExecutor::submitOrder from any producer
+// thread using only atomics.
+class OrderThrottle {
+public:
+    // Rates per second, bursts in orders / currency; a zero rate disables
+    struct Limits {
+        double max_orders_per_second = 0.0;
+        double order_burst = 0.0;
+        double max_notional_per_second = 0.0;
+        double notional_burst = 0.0;
+        double symbol_max_orders_per_second = 0.0;
+        double symbol_order_burst = 0.0;
+        double symbol_max_notional_per_second = 0.0;
+        double symbol_notional_burst = 0.0;
+    };
+
+    // prices values market orders for the notional buckets
+    explicit OrderThrottle(const Limits& limits, const PriceTable* prices = nullptr,
+                           size_t symbol_capacity = SymbolTable::kMaxSymbols);
+
+    RiskRejectReason check(const Order& order);
+    RiskRejectReason check(const Order& order, int64_t now_ns);
+
+    KillSwitch& killSwitch() { return kill_switch_; }
+    const KillSwitch& killSwitch() const { return kill_switch_; }
+
+private:
+    struct SymbolBuckets {
+        TokenBucket orders;
+        TokenBucket notional;
+    };
+
+    Limits limits_;
+    const PriceTable* prices_;
+    KillSwitch kill_switch_;
+    TokenBucket orders_;
+    TokenBucket notional_;
+    size_t symbol_capacity_;
+    std::unique_ptr<SymbolBuckets[]> symbols_;  // Only allocated with per-symbol limits
+};
+
+} // namespace trading
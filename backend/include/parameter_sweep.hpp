@@ -0,0 +1,102 @@
+#pragma once
+#include "backtest_engine.hpp"
+#include "common/span.hpp"
+#include "common/work_stealing_pool.hpp"
+#include "strategy.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+// One dimension of the search space, inclusive of both ends
+struct ParameterRange {
+    std::string name;
+    double min = 0.0;
+    double max = 0.0;
+    double step = 1.0;     // Grid spacing; random and genetic search round to it
+    bool integer = true;
+};
+
+struct SweepSpec {
+    enum class Mode {
+        GRID,     // Every combination of the ranges' steps
+        RANDOM,   // samples uniform draws
+        GENETIC   // Tournament selection, uniform crossover, mutation
+    };
+
+    struct Genetic {
+        size_t population = 64;
+        size_t generations = 20;
+        size_t elite = 4;            // Carried over unchanged
+        size_t tournament = 3;
+        double crossover_rate = 0.8;
+        double mutation_rate = 0.2;  // Per parameter
+        double mutation_scale = 0.1; // Std dev as a share of the range
+    };
+
+    Mode mode = Mode::GRID;
+    std::vector<ParameterRange> parameters;
+    size_t samples = 1000;  // RANDOM
+    Genetic genetic;
+    uint64_t seed = 0x5eed;
+};
+
+struct SweepEvaluation {
+    std::vector<double> parameters;  // In SweepSpec::parameters order
+    double score = 0.0;
+    BacktestResult result;           // Without equity curve and trades
+};
+
+// Backtest defaults for sweeps. Each evaluation builds its own engine, so
+// the order pool, and the order table sized from it, hold one strategy's
+// open orders rather than a live session's.
+inline BacktestEngine::Options sweepBacktestOptions() {
+    BacktestEngine::Options options;
+    options.order_pool_capacity = 4096;
+    return options;
+}
+
+// Runs one backtest per parameter set across a WorkStealingPool. Every
+// worker replays the same read-only ticks (typically a TickFile mapping),
+// so memory does not grow with the thread count; everything a backtest
+// writes is private to its evaluation. Results do not depend on the
+// number of threads.
+class ParameterSweep {
+public:
+    // Returns nullptr for parameter sets the strategy cannot use; those
+    // are skipped
+    using StrategyFactory = std::function<std::unique_ptr<Strategy>(const std::vector<double>&)>;
+    // Higher is better
+    using Objective = std::function<double(const BacktestResult&)>;
+
+    struct Options {
+        size_t threads = 0;  // 0: one per hardware thread
+        BacktestEngine::Options backtest = sweepBacktestOptions();
+        Objective objective;  // Default: total return
+    };
+
+    ParameterSweep(StrategyFactory factory, const Options& options);
+
+    // Evaluations sorted best first
+    std::vector<SweepEvaluation> run(const SweepSpec& spec, Span<const MarketData> ticks) const;
+
+    // Every grid point of spec, in lexicographic order
+    static std::vector<std::vector<double>> gridPoints(const SweepSpec& spec);
+
+private:
+    // Slots for parameter sets the factory refused hold a -inf score
+    std::vector<SweepEvaluation> evaluate(WorkStealingPool& pool, const std::vector<std::vector<double>>& points,
+                                          Span<const MarketData> ticks) const;
+    std::vector<SweepEvaluation> runGenetic(WorkStealingPool& pool, const SweepSpec& spec,
+                                            Span<const MarketData> ticks) const;
+
+    StrategyFactory factory_;
+    Options options_;
+};
+
+// Factory for MovingAverageStrategy from (short_period, long_period)
+ParameterSweep::StrategyFactory movingAverageFactory();
+
+} // namespace trading
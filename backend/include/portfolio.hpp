@@ -0,0 +1,238 @@
+#pragma once
+#include "common/types.hpp"
+#include "common/rolling_window.hpp"
+#include "common/symbol_state.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace trading {
+
+// Position Class
+class Position {
+public:
+    explicit Position(SymbolId symbol) : symbol_(symbol) {}
+
+    // Applies a signed fill (positive buys) and returns the realized P&L
+    double applyFill(double quantity, double price) {
+        double realized = 0.0;
+        double new_quantity = quantity_ + quantity;
+
+        if (quantity_ == 0.0 || (quantity_ > 0.0) == (quantity > 0.0)) {
+            // Opening or adding: blend the average price. An empty fill on a
+            // flat position has nothing to blend.
+            if (new_quantity != 0.0) {
+                average_price_ = (average_price_ * quantity_ + price * quantity) / new_quantity;
+            }
+        } else {
+            // Reducing, closing or flipping: realize P&L on the closed part
+            double closed = std::min(std::abs(quantity), std::abs(quantity_));
+            realized = closed * (price - average_price_) * (quantity_ > 0.0 ? 1.0 : -1.0);
+            if (new_quantity == 0.0) {
+                average_price_ = 0.0;
+            } else if ((new_quantity > 0.0) != (quantity_ > 0.0)) {
+                average_price_ = price;
+            }
+        }
+
+        quantity_ = new_quantity;
+        last_price_ = price;
+        realized_pnl_ += realized;
+        return realized;
+    }
+
+    void mark(double price) { last_price_ = price; }
+
+    SymbolId getSymbol() const { return symbol_; }
+    double getQuantity() const { return quantity_; }
+    double getAveragePrice() const { return average_price_; }
+    double getLastPrice() const { return last_price_; }
+    double getRealizedPnL() const { return realized_pnl_; }
+    double getMarketValue() const { return quantity_ * last_price_; }
+    double getUnrealizedPnL() const { return quantity_ * (last_price_ - average_price_); }
+    double getMarketValue(double current_price) const { return quantity_ * current_price; }
+    double getUnrealizedPnL(double current_price) const {
+        return quantity_ * (current_price - average_price_);
+    }
+
+private:
+    SymbolId symbol_;
+    double quantity_ = 0.0;
+    double average_price_ = 0.0;
+    double last_price_ = 0.0;
+    double realized_pnl_ = 0.0;
+};
+
+// Portfolio Class
+// Keeps running market value, gross exposure and unrealized P&L, updated
+// in O(1) on every fill or mark, so valuation queries never rescan
+// positions. High-water mark, drawdown and session P&L ride on the same
+// updates.
+class Portfolio {
+public:
+    explicit Portfolio(double initial_cash = 1000000.0)
+        : cash_(initial_cash), high_water_mark_(initial_cash), session_start_value_(initial_cash) {}
+
+    // Updates the position only; cash is left to the caller
+    void updatePosition(SymbolId symbol, double quantity, double price) {
+        applyToPosition(symbol, quantity, price);
+        updatePerformance();
+    }
+
+    // Applies a signed fill to both the position and cash
+    void applyFill(SymbolId symbol, double quantity, double price, double commission = 0.0) {
+        applyToPosition(symbol, quantity, price);
+        cash_ -= quantity * price + commission;
+        updatePerformance();
+    }
+
+    // Marks an existing position to a new price; no-op for other symbols
+    void markPrice(SymbolId symbol, double price) {
+        Position* position = positions_.find(symbol);
+        if (!position || position->getLastPrice() == price) {
+            return;
+        }
+        Contribution before = contributionOf(*position);
+        position->mark(price);
+        updateAggregates(*position, before);
+        updatePerformance();
+    }
+
+    // Sessions roll at this offset from UTC midnight (default midnight)
+    void setSessionRoll(std::chrono::seconds offset_from_midnight) {
+        session_offset_ = offset_from_midnight;
+        next_roll_ = Timestamp();
+    }
+
+    // Advances the session clock; the first call after the roll boundary
+    // starts a new session from the current value. O(1).
+    void advanceClock(Timestamp now) {
+        if (now < next_roll_) {
+            return;
+        }
+        using Day = std::chrono::duration<int64_t, std::ratio<86400>>;
+        auto since_roll = now.time_since_epoch() - session_offset_;
+        auto day_start = std::chrono::floor<Day>(since_roll);
+        bool first = next_roll_ == Timestamp();
+        next_roll_ = Timestamp(std::chrono::duration_cast<Timestamp::duration>(
+            day_start + Day(1) + session_offset_));
+        if (!first) {
+            session_start_value_ = getTotalValue();
+            daily_pnl_ = 0.0;
+        }
+    }
+
+    double getTotalValue() const { return cash_ + market_value_.value(); }
+    double getMarketValue() const { return market_value_.value(); }
+    double getUnrealizedPnL() const { return unrealized_pnl_.value(); }
+    double getRealizedPnL() const { return realized_pnl_; }
+
+    double getCash() const { return cash_; }
+    void updateCash(double amount) {
+        cash_ += amount;
+        updatePerformance();
+    }
+
+    const Position* getPosition(SymbolId symbol) const { return positions_.find(symbol); }
+
+    // Gross exposure, sum of |market value| over positions
+    double getTotalExposure() const { return gross_exposure_.value(); }
+
+    double getLeverage() const {
+        double total = getTotalValue();
+        return total > 0.0 ? getTotalExposure() / total : 0.0;
+    }
+
+    // Share of total value held in one symbol
+    double getConcentration(SymbolId symbol) const {
+        const Position* position = positions_.find(symbol);
+        double total = getTotalValue();
+        return (position && total > 0.0) ? std::abs(position->getMarketValue()) / total : 0.0;
+    }
+
+    // Largest single-position share of total value. The largest position is
+    // cached and only rescanned after it shrinks, so this is amortized O(1).
+    double getConcentration() const {
+        if (largest_dirty_) {
+            largest_value_ = 0.0;
+            positions_.forEach([this](SymbolId symbol, const Position& position) {
+                double value = std::abs(position.getMarketValue());
+                if (value > largest_value_) {
+                    largest_value_ = value;
+                    largest_symbol_ = symbol;
+                }
+            });
+            largest_dirty_ = false;
+        }
+        double total = getTotalValue();
+        return total > 0.0 ? largest_value_ / total : 0.0;
+    }
+
+    // Fractional decline of total value from its high-water mark
+    double getDrawdown() const { return drawdown_; }
+    double getHighWaterMark() const { return high_water_mark_; }
+    // Change in total value since the current session started
+    double getDailyPnL() const { return daily_pnl_; }
+    double getSessionStartValue() const { return session_start_value_; }
+
+    template <typename F>
+    void forEachPosition(F&& f) const { positions_.forEach(std::forward<F>(f)); }
+
+private:
+    struct Contribution {
+        double market_value;
+        double unrealized_pnl;
+    };
+
+    static Contribution contributionOf(const Position& position) {
+        return {position.getMarketValue(), position.getUnrealizedPnL()};
+    }
+
+    void updateAggregates(const Position& position, const Contribution& before) {
+        Contribution after = contributionOf(position);
+        market_value_.add(after.market_value - before.market_value);
+        gross_exposure_.add(std::abs(after.market_value) - std::abs(before.market_value));
+        unrealized_pnl_.add(after.unrealized_pnl - before.unrealized_pnl);
+
+        double value = std::abs(after.market_value);
+        if (value >= largest_value_) {
+            largest_value_ = value;
+            largest_symbol_ = position.getSymbol();
+        } else if (position.getSymbol() == largest_symbol_) {
+            largest_dirty_ = true;
+        }
+    }
+
+    void applyToPosition(SymbolId symbol, double quantity, double price) {
+        Position& position = positions_.getOrCreate(symbol, symbol);
+        Contribution before = contributionOf(position);
+        realized_pnl_ += position.applyFill(quantity, price);
+        updateAggregates(position, before);
+    }
+
+    void updatePerformance() {
+        double value = getTotalValue();
+        high_water_mark_ = std::max(high_water_mark_, value);
+        drawdown_ = high_water_mark_ > 0.0 ? (high_water_mark_ - value) / high_water_mark_ : 0.0;
+        daily_pnl_ = value - session_start_value_;
+    }
+
+    double cash_;  // Initial capital 1 million by default
+    SymbolStateTable<Position> positions_;
+    CompensatedSum<double> market_value_;
+    CompensatedSum<double> gross_exposure_;
+    CompensatedSum<double> unrealized_pnl_;
+    double realized_pnl_ = 0.0;
+    mutable double largest_value_ = 0.0;
+    mutable SymbolId largest_symbol_ = kInvalidSymbol;
+    mutable bool largest_dirty_ = false;
+    double high_water_mark_;
+    double drawdown_ = 0.0;
+    double session_start_value_;
+    double daily_pnl_ = 0.0;
+    std::chrono::seconds session_offset_{0};
+    Timestamp next_roll_{};
+};
+
+} // namespace trading
@@ -0,0 +1,71 @@
+#pragma once
+#include "common/types.hpp"
+#include "common/seqlock.hpp"
+#include <memory>
+
+namespace trading {
+
+// Latest price and top of book for one symbol
+struct Quote {
+    double last_price = 0.0;
+    double bid = 0.0;
+    double ask = 0.0;
+    double bid_size = 0.0;
+    double ask_size = 0.0;
+    double volume = 0.0;
+    Timestamp timestamp{};
+};
+
+// Symbol-indexed last-price / top-of-book table. The ingest path writes
+// each symbol from a single thread; sizing, strategy and risk code read
+// lock-free with no I/O. One cache line per symbol.
+class PriceTable {
+public:
+    explicit PriceTable(size_t capacity = SymbolTable::kMaxSymbols)
+        : capacity_(capacity), entries_(new Entry[capacity]) {}
+
+    // Records a tick; bid/ask are kept from the last full quote update
+    void update(const MarketData& data) {
+        if (data.symbol_id >= capacity_) {
+            return;
+        }
+        auto& entry = entries_[data.symbol_id].quote;
+        Quote quote = entry.load();
+        quote.last_price = data.last_price;
+        quote.volume = data.volume;
+        quote.timestamp = data.timestamp;
+        entry.store(quote);
+    }
+
+    void update(SymbolId symbol, const Quote& quote) {
+        if (symbol < capacity_) {
+            entries_[symbol].quote.store(quote);
+        }
+    }
+
+    // Returns false if the symbol has never been updated
+    bool getQuote(SymbolId symbol, Quote& out) const {
+        if (symbol >= capacity_) {
+            return false;
+        }
+        out = entries_[symbol].quote.load();
+        return entries_[symbol].quote.sequence() != 0;
+    }
+
+    // 0.0 if the symbol has never been updated
+    double getLastPrice(SymbolId symbol) const {
+        return (symbol < capacity_) ? entries_[symbol].quote.load().last_price : 0.0;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct alignas(kCacheLineSize) Entry {
+        SeqLock<Quote> quote;
+    };
+
+    size_t capacity_;
+    std::unique_ptr<Entry[]> entries_;
+};
+
+} // namespace trading
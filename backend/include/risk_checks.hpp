@@ -0,0 +1,164 @@
+#pragma once
+#include "common/types.hpp"
+#include "portfolio.hpp"
+#include "risk_reject_reason.hpp"
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace trading {
+
+struct RiskVerdict {
+    RiskRejectReason reason = RiskRejectReason::NONE;
+
+    bool accepted() const { return reason == RiskRejectReason::NONE; }
+    explicit operator bool() const { return accepted(); }
+};
+
+// Limits are fractions of portfolio value, except max_leverage which is a
+// multiple of it
+struct RiskLimits {
+    double max_position_size;
+    double max_drawdown;
+    double max_leverage;
+    // Intraday loss as a fraction of the value at the session start. Once
+    // breached, only orders that shrink a position are accepted.
+    double daily_loss_limit;
+    double position_concentration;
+    // Tail limits as a fraction of portfolio value; 0 disables. While
+    // breached, only orders that shrink a position are accepted.
+    double max_var = 0.0;
+    double max_expected_shortfall = 0.0;
+};
+
+// Latest scenario-based VaR / ES, in currency
+struct TailRisk {
+    double var = 0.0;
+    double expected_shortfall = 0.0;
+};
+
+// Everything a check may look at, computed once per order
+struct OrderRiskContext {
+    double order_value;
+    double portfolio_value;
+    double current_exposure;  // |position| in the order's symbol, before the order
+    double new_exposure;      // ... and after it
+    double total_exposure;    // Gross exposure after the order
+    double drawdown;
+    double daily_pnl;
+    double session_start_value;
+    TailRisk tail;
+};
+
+inline OrderRiskContext makeOrderRiskContext(const Order& order, double price, double current_quantity,
+                                             double gross_exposure, const TailRisk& tail,
+                                             const Portfolio& portfolio) {
+    double signed_quantity = order.getSide() == OrderSide::BUY ? order.getQuantity() : -order.getQuantity();
+    OrderRiskContext context;
+    context.order_value = order.getQuantity() * price;
+    context.portfolio_value = portfolio.getTotalValue();
+    context.current_exposure = std::abs(current_quantity * price);
+    context.new_exposure = std::abs((current_quantity + signed_quantity) * price);
+    context.total_exposure = gross_exposure - context.current_exposure + context.new_exposure;
+    context.drawdown = portfolio.getDrawdown();
+    context.daily_pnl = portfolio.getDailyPnL();
+    context.session_start_value = portfolio.getSessionStartValue();
+    context.tail = tail;
+    return context;
+}
+
+// Individual checks. Each is a stateless type with the reason it reports
+// and a branch-free violated() predicate; limits are compared scaled by
+// portfolio value rather than dividing.
+struct PositionSizeCheck {
+    static constexpr RiskRejectReason kReason = RiskRejectReason::POSITION_SIZE;
+    static bool violated(const OrderRiskContext& c, const RiskLimits& limits) {
+        return c.order_value > limits.max_position_size * c.portfolio_value;
+    }
+};
+
+struct LeverageCheck {
+    static constexpr RiskRejectReason kReason = RiskRejectReason::LEVERAGE;
+    static bool violated(const OrderRiskContext& c, const RiskLimits& limits) {
+        return c.total_exposure > limits.max_leverage * c.portfolio_value;
+    }
+};
+
+struct DrawdownCheck {
+    static constexpr RiskRejectReason kReason = RiskRejectReason::DRAWDOWN;
+    static bool violated(const OrderRiskContext& c, const RiskLimits& limits) {
+        return c.drawdown > limits.max_drawdown;
+    }
+};
+
+struct DailyLossCheck {
+    static constexpr RiskRejectReason kReason = RiskRejectReason::DAILY_LOSS;
+    static bool violated(const OrderRiskContext& c, const RiskLimits& limits) {
+        return (c.daily_pnl < -limits.daily_loss_limit * c.session_start_value) &
+               (c.new_exposure > c.current_exposure);
+    }
+};
+
+struct ConcentrationCheck {
+    static constexpr RiskRejectReason kReason = RiskRejectReason::CONCENTRATION;
+    static bool violated(const OrderRiskContext& c, const RiskLimits& limits) {
+        return c.new_exposure > limits.position_concentration * c.portfolio_value;
+    }
+};
+
+struct VarCheck {
+    static constexpr RiskRejectReason kReason = RiskRejectReason::VAR;
+    static bool violated(const OrderRiskContext& c, const RiskLimits& limits) {
+        return (limits.max_var > 0.0) & (c.tail.var > limits.max_var * c.portfolio_value) &
+               (c.new_exposure > c.current_exposure);
+    }
+};
+
+struct ExpectedShortfallCheck {
+    static constexpr RiskRejectReason kReason = RiskRejectReason::EXPECTED_SHORTFALL;
+    static bool violated(const OrderRiskContext& c, const RiskLimits& limits) {
+        return (limits.max_expected_shortfall > 0.0) &
+               (c.tail.expected_shortfall > limits.max_expected_shortfall * c.portfolio_value) &
+               (c.new_exposure > c.current_exposure);
+    }
+};
+
+// Compile-time chain of checks. Every check is evaluated into one bit of a
+// mask and the first failing check, in chain order, is reported, so the
+// whole chain inlines into a single branch-light function. Checks left out
+// of a chain cost nothing.
+template <typename... Checks>
+class RiskCheckChain {
+    static_assert(sizeof...(Checks) <= 32, "RiskCheckChain supports at most 32 checks");
+
+public:
+    static constexpr size_t size() { return sizeof...(Checks); }
+
+    static RiskVerdict evaluate(const OrderRiskContext& context, const RiskLimits& limits) {
+        if constexpr (sizeof...(Checks) == 0) {
+            return {};
+        } else {
+            constexpr RiskRejectReason kReasons[] = {Checks::kReason...};
+            uint32_t violations = collect(context, limits, std::index_sequence_for<Checks...>());
+            return {violations ? kReasons[__builtin_ctz(violations)] : RiskRejectReason::NONE};
+        }
+    }
+
+private:
+    template <size_t... Index>
+    static uint32_t collect(const OrderRiskContext& context, const RiskLimits& limits,
+                            std::index_sequence<Index...>) {
+        return (0u | ... | (uint32_t(Checks::violated(context, limits)) << Index));
+    }
+};
+
+// Full set, in the historical evaluation order
+using DefaultRiskChecks = RiskCheckChain<PositionSizeCheck, LeverageCheck, DrawdownCheck,
+                                         DailyLossCheck, ConcentrationCheck, VarCheck,
+                                         ExpectedShortfallCheck>;
+using EquityRiskChecks = DefaultRiskChecks;
+// Crypto trades around the clock, so there is no session loss limit
+using CryptoRiskChecks = RiskCheckChain<PositionSizeCheck, LeverageCheck, DrawdownCheck,
+                                        ConcentrationCheck, VarCheck, ExpectedShortfallCheck>;
+
+} // namespace trading
@@ -1,30 +1,188 @@
 #pragma once
 #include "common/types.hpp"
+#include "portfolio.hpp"
+#include "risk_checks.hpp"
+#include "price_table.hpp"
+#include "var_engine.hpp"
+#include "common/seqlock.hpp"
+#include "common/span.hpp"
+#include <array>
+#include <cstdint>
 #include <memory>
-#include <map>
-#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 namespace trading {
 
+// Point-in-time risk snapshot published by RiskManager
+struct RiskMetrics {
+    double drawdown = 0.0;
+    double leverage = 0.0;
+    double daily_pnl = 0.0;
+    double concentration = 0.0;
+    double total_exposure = 0.0;
+    double total_value = 0.0;
+    double var = 0.0;             // Parametric VaR at the configured confidence
+    double cvar = 0.0;            // Parametric expected shortfall
+    double historical_var = 0.0;
+    double historical_cvar = 0.0;
+    double simulated_var = 0.0;   // Latest Monte Carlo run
+    double simulated_expected_shortfall = 0.0;
+    Timestamp timestamp{};
+};
+
 class RiskManager {
 public:
-    struct RiskLimits {
-        double max_position_size;
-        double max_drawdown;
-        double max_leverage;
-        double daily_loss_limit;
-        double position_concentration;
-    };
+    using RiskLimits = trading::RiskLimits;
+
+    // prices values market orders, which carry no limit price
+    explicit RiskManager(const RiskLimits& limits, const PriceTable* prices = nullptr);
+
+    // Lock-free, allocation-free pre-trade check on the portfolio's running
+    // counters. Does not log; safe to call from any thread that owns portfolio.
+    RiskVerdict checkOrder(const Order& order, const Portfolio& portfolio) const {
+        return checkOrderWith<DefaultRiskChecks>(order, portfolio);
+    }
 
-    RiskManager(const RiskLimits& limits);
+    // checkOrder with a deployment-specific chain, e.g. CryptoRiskChecks
+    template <typename Chain>
+    RiskVerdict checkOrderWith(const Order& order, const Portfolio& portfolio) const {
+        double price = priceFor(order);
+        if (price <= 0.0 && prices_) {
+            return {RiskRejectReason::NO_PRICE};
+        }
+        const Position* position = portfolio.getPosition(order.getSymbol());
+        double current_quantity = position ? position->getQuantity() : 0.0;
+        return Chain::evaluate(makeOrderRiskContext(order, price, current_quantity,
+                                                    portfolio.getTotalExposure(),
+                                                    tail_risk_.load(), portfolio),
+                               limits_);
+    }
+
+    // checkOrder plus a warning log on rejection
     bool checkOrderRisk(const Order& order, const Portfolio& portfolio);
-    void updateRiskMetrics(const Portfolio& portfolio);
-    std::map<std::string, double> getRiskMetrics() const;
+    // Checks orders in sequence against one portfolio snapshot. Each accepted
+    // order's exposure is carried into the checks that follow it, so the
+    // batch as a whole respects leverage and concentration limits.
+    //
+    // Writes the verdict for orders[i] to verdicts[i]. With a caller-owned
+    // buffer, batches of up to 32 symbols do not allocate. Throws
+    // std::invalid_argument if verdicts is shorter than orders.
+    void checkOrderBatch(Span<const Order* const> orders, const Portfolio& portfolio,
+                         Span<RiskVerdict> verdicts) const {
+        checkOrderBatchWith<DefaultRiskChecks>(orders, portfolio, verdicts);
+    }
+
+    // As above, into a new vector
+    std::vector<RiskVerdict> checkOrderBatch(Span<const Order* const> orders,
+                                             const Portfolio& portfolio) const {
+        std::vector<RiskVerdict> verdicts(orders.size());
+        checkOrderBatch(orders, portfolio, verdicts);
+        return verdicts;
+    }
+
+    template <typename Chain>
+    void checkOrderBatchWith(Span<const Order* const> orders, const Portfolio& portfolio,
+                             Span<RiskVerdict> verdicts) const;
+
+    // Latest scenario-based VaR / ES in currency; call from a single writer
+    void updateTailRisk(double var, double expected_shortfall);
+
+    // Publishes a new snapshot; call from a single writer thread
+    void updateRiskMetrics(const Portfolio& portfolio, const VarEstimate& var = VarEstimate());
+    // Consistent snapshot for any thread; never blocks the writer
+    RiskMetrics getRiskMetrics() const { return metrics_.load(); }
+    // Number of snapshots published so far
+    uint64_t getMetricsVersion() const { return metrics_.sequence() / 2; }
 
 private:
+    // Resolves the price used to value an order; 0 if none is available
+    double priceFor(const Order& order) const {
+        double price = order.getPrice();
+        if (price == 0.0 && prices_) {
+            price = prices_->getLastPrice(order.getSymbol());
+        }
+        return price;
+    }
+
+    // Running quantity per symbol over a batch. Batches touch few symbols,
+    // so the first kInlineSymbols sit in an array scanned linearly and a
+    // typical batch never allocates; any further symbols go to a map.
+    class BatchQuantities {
+    public:
+        // nullptr if symbol has no entry yet
+        double* find(SymbolId symbol) {
+            for (size_t i = 0; i < size_; ++i) {
+                if (symbols_[i] == symbol) {
+                    return &quantities_[i];
+                }
+            }
+            if (overflow_.empty()) {
+                return nullptr;
+            }
+            auto it = overflow_.find(symbol);
+            return it != overflow_.end() ? &it->second : nullptr;
+        }
+
+        double* insert(SymbolId symbol, double quantity) {
+            if (size_ < kInlineSymbols) {
+                symbols_[size_] = symbol;
+                quantities_[size_] = quantity;
+                return &quantities_[size_++];
+            }
+            return &overflow_.emplace(symbol, quantity).first->second;
+        }
+
+    private:
+        static constexpr size_t kInlineSymbols = 32;
+        std::array<SymbolId, kInlineSymbols> symbols_;
+        std::array<double, kInlineSymbols> quantities_;
+        size_t size_ = 0;
+        std::unordered_map<SymbolId, double> overflow_;
+    };
+
     RiskLimits limits_;
-    std::map<std::string, double> current_metrics_;
-    std::mutex mutex_;
+    const PriceTable* prices_;
+    SeqLock<RiskMetrics> metrics_;
+    SeqLock<TailRisk> tail_risk_;
 };
 
+template <typename Chain>
+void RiskManager::checkOrderBatchWith(Span<const Order* const> orders, const Portfolio& portfolio,
+                                      Span<RiskVerdict> verdicts) const {
+    if (verdicts.size() < orders.size()) {
+        throw std::invalid_argument("Verdict buffer is shorter than the order batch");
+    }
+
+    // Running quantity per symbol, including earlier accepted orders in the batch
+    BatchQuantities quantities;
+    double gross_exposure = portfolio.getTotalExposure();
+    TailRisk tail = tail_risk_.load();
+
+    for (size_t i = 0; i < orders.size(); ++i) {
+        const Order& order = *orders[i];
+        double price = priceFor(order);
+        if (price <= 0.0 && prices_) {
+            verdicts[i] = {RiskRejectReason::NO_PRICE};
+            continue;
+        }
+
+        SymbolId symbol = order.getSymbol();
+        double* quantity = quantities.find(symbol);
+        if (!quantity) {
+            const Position* position = portfolio.getPosition(symbol);
+            quantity = quantities.insert(symbol, position ? position->getQuantity() : 0.0);
+        }
+
+        OrderRiskContext context =
+            makeOrderRiskContext(order, price, *quantity, gross_exposure, tail, portfolio);
+        verdicts[i] = Chain::evaluate(context, limits_);
+        if (verdicts[i]) {
+            gross_exposure = context.total_exposure;
+            *quantity += order.getSide() == OrderSide::BUY ? order.getQuantity() : -order.getQuantity();
+        }
+    }
+}
+
 } // namespace trading 
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+namespace trading {
+
+// Why a pre-trade check rejected an order
+enum class RiskRejectReason : uint8_t {
+    NONE,
+    POSITION_SIZE,
+    LEVERAGE,
+    DRAWDOWN,
+    DAILY_LOSS,
+    CONCENTRATION,
+    NO_PRICE,
+    VAR,
+    EXPECTED_SHORTFALL,
+    KILL_SWITCH,
+    ORDER_RATE,
+    NOTIONAL_RATE
+};
+
+const char* toString(RiskRejectReason reason);
+
+} // namespace trading
@@ -0,0 +1,94 @@
+#pragma once
+#include "common/philox.hpp"
+#include "execution_venue.hpp"
+#include "matching_engine.hpp"
+#include "price_table.hpp"
+#include <chrono>
+#include <deque>
+#include <vector>
+
+namespace trading {
+
+// One-way delays between the engine and the simulated exchange. Jitter is
+// drawn from a seeded counter RNG, so a run is reproducible, and never
+// reorders messages on the same leg.
+struct LatencyModel {
+    std::chrono::nanoseconds order_latency{0};   // Engine to exchange
+    std::chrono::nanoseconds report_latency{0};  // Exchange to engine
+    std::chrono::nanoseconds jitter{0};          // Uniform extra delay, per message
+    uint64_t seed = 0x5eed;
+};
+
+// In-process exchange for OrderExecutor: a MatchingEngine behind a latency
+// model. Requests reach the book, and reports come back, only once their
+// delay has elapsed; poll() delivers whatever is due.
+//
+// Time is the wall clock by default. With simulated_clock it only moves
+// through advanceTo() and onTrade(), which makes runs deterministic.
+// Given a PriceTable, poll() also feeds new trades for symbols with open
+// orders to the book; with nothing in flight the executor polls on its
+// idle wake-up, so resting orders see those trades with that delay.
+class SimulatedExchange : public ExecutionVenue {
+public:
+    struct Options {
+        MatchingEngine::Options matching;
+        LatencyModel latency;
+        bool simulated_clock = false;
+    };
+
+    explicit SimulatedExchange(const Options& options, const PriceTable* prices = nullptr);
+
+    void submit(const Order& order) override;
+    void cancel(OrderId order_id) override;
+    void replace(OrderId order_id, double quantity, double price) override;
+    void poll() override;
+    bool idle() const override { return inbound_.empty() && outbound_.empty(); }
+    std::string describe() const override { return "simulated-exchange"; }
+
+    // Simulated clock: moves time forward, delivering whatever falls due
+    void advanceTo(Timestamp now);
+    // An outside trade. Call on the executor thread (or with the executor
+    // drained synchronously); with the simulated clock it also sets the time.
+    void onTrade(SymbolId symbol, double price, double quantity, Timestamp timestamp);
+
+    Timestamp now() const;
+    const MatchingEngine& engine() const { return engine_; }
+
+private:
+    struct Request {
+        enum class Type : uint8_t { NEW, CANCEL, REPLACE };
+        Type type = Type::NEW;
+        Timestamp due{};
+        Order order;                          // NEW
+        OrderId order_id = kInvalidOrderId;   // CANCEL, REPLACE
+        double quantity = 0.0;                // REPLACE
+        double price = 0.0;                   // REPLACE
+    };
+
+    struct PendingReport {
+        Timestamp due;
+        ExecutionReport report;
+    };
+
+    Timestamp delay(std::chrono::nanoseconds latency, Timestamp from, Timestamp& last_due);
+    void enqueue(Request request);
+    void deliverDue(Timestamp now);
+    void track(SymbolId symbol);
+    void pullTrades(SymbolId symbol);
+
+    Options options_;
+    const PriceTable* prices_;
+    MatchingEngine engine_;
+    Philox4x32 rng_;
+    uint64_t draws_ = 0;
+    Timestamp clock_{};
+    Timestamp last_inbound_due_{};
+    Timestamp last_outbound_due_{};
+    std::deque<Request> inbound_;
+    std::deque<PendingReport> outbound_;
+    // Per symbol: timestamp of the last PriceTable tick fed to the book
+    std::vector<Timestamp> seen_trades_;
+    std::vector<SymbolId> symbols_;  // Symbols ever ordered
+};
+
+} // namespace trading
@@ -1,5 +1,7 @@
 #pragma once
 #include "common/types.hpp"
+#include "common/rolling_window.hpp"
+#include "common/symbol_state.hpp"
 #include <vector>
 #include <memory>
 
@@ -8,7 +10,7 @@ namespace trading {
 class Strategy {
 public:
     struct Signal {
-        std::string symbol;
+        SymbolId symbol;
         OrderSide side;
         double strength;  // Signal strength [-1, 1]
         Timestamp timestamp;
@@ -20,6 +22,16 @@ public:
     virtual void onOrderUpdate(const Order& order) = 0;
 };
 
+// Order quantity for a signal: position_size_limit of the portfolio value
+// at full strength, scaled down by the signal strength. 0 without a price.
+inline double signalOrderQuantity(const Strategy::Signal& signal, double price,
+                                  double portfolio_value, double position_size_limit) {
+    if (price <= 0.0) {
+        return 0.0;
+    }
+    return portfolio_value * position_size_limit * signal.strength / price;
+}
+
 // Moving Average Strategy
 class MovingAverageStrategy : public Strategy {
 public:
@@ -29,9 +41,19 @@ public:
     void onOrderUpdate(const Order& order) override;
 
 private:
+    // Rolling state kept separately for every symbol, so an instance can be
+    // given any subset of symbols (e.g. one shard) without locking
+    struct SymbolState {
+        SymbolState(int short_period, int long_period)
+            : short_window(short_period), long_window(long_period) {}
+
+        RollingWindow<double> short_window;
+        RollingWindow<double> long_window;
+    };
+
     int short_period_;
     int long_period_;
-    std::vector<double> prices_;
+    SymbolStateTable<SymbolState> states_;
 };
 
 } // namespace trading
\ No newline at end of file
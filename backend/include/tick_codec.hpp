@@ -0,0 +1,73 @@
+#pragma once
+#include "common/span.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace trading {
+
+// Block codec for tick store columns.
+//
+// A column is cut into blocks of kBlockSize values, and the column header
+// holds the offset of every block so any block can be decoded alone. Each
+// block picks whichever transform packs narrowest:
+// - frame of reference: value minus the block minimum, for volumes;
+// - zigzag delta: for prices that move a few ticks at a time;
+// - delta of delta: for regularly spaced timestamps, which pack to zero
+//   bits.
+// The residuals are divided by their greatest common divisor, so
+// microsecond timestamps or round-lot volumes spend no bits on it, and
+// then bit-packed at the block's width.
+//
+// Doubles are stored as scaled integers when every value has at most 9
+// decimal places and round-trips exactly. That holds for quoted prices
+// and share volumes. Other doubles fall back to XOR with the previous
+// value, with the common trailing zero bits dropped. Decoding is lossless
+// in every case.
+namespace tick_codec {
+
+constexpr size_t kBlockSize = 128;
+
+enum class Encoding : uint8_t {
+    INTEGER,  // int64 values
+    DECIMAL,  // Doubles as int64 multiples of 10^-decimals
+    XOR       // Doubles as the XOR of consecutive bit patterns
+};
+
+// Append one encoded column to out
+void encodeIntegers(Span<const int64_t> values, std::vector<uint8_t>& out);
+void encodeDoubles(Span<const double> values, std::vector<uint8_t>& out);
+
+// Random access to an encoded column. Holds no copy of the data.
+class ColumnDecoder {
+public:
+    // Throws std::runtime_error if column is not an encoded column of
+    // count values
+    ColumnDecoder(Span<const uint8_t> column, size_t count);
+
+    Encoding encoding() const { return encoding_; }
+    size_t blockCount() const { return block_count_; }
+    size_t valueCount() const { return count_; }
+
+    // First value of block, without decoding it. For INTEGER columns.
+    int64_t firstInteger(size_t block) const;
+
+    // Decode blocks [first, last) into out, which must hold their values:
+    // kBlockSize per block, fewer for the final one. The integer overload
+    // is for INTEGER columns and the double one for the others.
+    void decode(size_t first, size_t last, int64_t* out) const;
+    void decode(size_t first, size_t last, double* out) const;
+
+private:
+    const uint8_t* block(size_t index) const;
+    size_t decodeBlock(size_t index, uint64_t* out) const;
+
+    Span<const uint8_t> column_;
+    size_t count_;
+    size_t block_count_;
+    Encoding encoding_;
+    double scale_ = 1.0;  // 10^decimals for DECIMAL
+};
+
+} // namespace tick_codec
+
+} // namespace trading
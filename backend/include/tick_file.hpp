@@ -0,0 +1,31 @@
+#pragma once
+#include "common/mapped_file.hpp"
+#include "common/span.hpp"
+#include "common/types.hpp"
+#include <string>
+
+namespace trading {
+
+// Flat file of MarketData records behind a small header, read through a
+// shared read-only mapping: replaying workers all see one copy in the page
+// cache and nothing is parsed. The records are the in-memory layout, so a
+// file is only valid for builds with the same MarketData; the header
+// carries the record size to catch mismatches. A local cache format, not
+// an archive format.
+class TickFile {
+public:
+    // Throws std::runtime_error on I/O failure
+    static void write(const std::string& path, Span<const MarketData> ticks);
+
+    // Throws std::runtime_error if the file is missing or not a tick file
+    explicit TickFile(const std::string& path);
+
+    Span<const MarketData> ticks() const { return ticks_; }
+    size_t size() const { return ticks_.size(); }
+
+private:
+    MappedFile file_;
+    Span<const MarketData> ticks_;
+};
+
+} // namespace trading
@@ -0,0 +1,172 @@
+#pragma once
+#include "common/mapped_file.hpp"
+#include "common/span.hpp"
+#include "common/types.hpp"
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trading {
+
+// Columnar archive of ticks or bars for many symbols.
+//
+// Data is cut into one chunk per symbol and UTC day. A chunk stores each
+// field as its own column: timestamps as int64 epoch nanoseconds, and
+// prices and volumes as doubles. Only bar chunks carry open/high/low.
+// A column is either raw and 64-byte aligned, or packed with tick_codec.
+// A footer at the end of the file indexes the chunks, sorted by symbol and
+// then time, plus the symbol names. Opening a store maps the file and
+// reads only the symbol table. Chunk lookups binary search the mapped
+// index. Raw columns are handed out as spans into the mapping; packed
+// columns are decoded block by block, and only the blocks that overlap
+// the requested range.
+namespace tick_store {
+
+enum class Column : uint8_t { TIMESTAMP, PRICE, OPEN, HIGH, LOW, VOLUME, COUNT };
+constexpr size_t kColumnCount = static_cast<size_t>(Column::COUNT);
+
+enum class Encoding : uint8_t {
+    RAW,    // Array of int64 or double
+    PACKED  // tick_codec column
+};
+
+struct ColumnRef {
+    uint64_t offset;  // 0: column absent
+    uint64_t bytes;
+};
+
+// Footer index record, one per chunk
+struct ChunkEntry {
+    uint32_t symbol;  // Index into the store's symbol table
+    int32_t day;      // UTC days since the epoch
+    uint64_t count;
+    int64_t first_ns;
+    int64_t last_ns;
+    ColumnRef columns[kColumnCount];
+    Encoding encodings[kColumnCount];
+    uint8_t reserved[2];
+};
+
+} // namespace tick_store
+
+// Writes a store front to back; the footer is written by finish().
+class TickStoreWriter {
+public:
+    enum class Layout {
+        TICKS,  // timestamp, last_price, volume
+        BARS    // Adds open, high, low
+    };
+
+    enum class Compression {
+        NONE,   // Raw columns, readable without decoding
+        PACKED  // tick_codec columns, typically 5-10x smaller
+    };
+
+    // Throws std::runtime_error if the file cannot be created
+    explicit TickStoreWriter(const std::string& path, Compression compression = Compression::PACKED);
+    // Finishes the store if finish() was not called; errors are logged
+    ~TickStoreWriter();
+
+    TickStoreWriter(const TickStoreWriter&) = delete;
+    TickStoreWriter& operator=(const TickStoreWriter&) = delete;
+
+    // Ticks of a single symbol in time order, continuing after anything
+    // already appended for it. Split into chunks at UTC midnight; a day
+    // appended across several calls spans several chunks. Throws
+    // std::invalid_argument on mixed symbols or out-of-order timestamps.
+    void append(Span<const MarketData> ticks, Layout layout = Layout::TICKS);
+
+    // Writes the footer and closes the file
+    void finish();
+
+private:
+    void writeChunk(uint32_t symbol, int32_t day, Span<const MarketData> ticks, Layout layout);
+    template <typename T>
+    void writeColumn(tick_store::ChunkEntry& entry, tick_store::Column column, const std::vector<T>& values);
+    void writeBytes(const void* data, size_t bytes);
+    void alignTo(size_t alignment);
+
+    struct FileCloser {
+        void operator()(FILE* file) const { std::fclose(file); }
+    };
+
+    std::string path_;
+    Compression compression_;
+    std::unique_ptr<FILE, FileCloser> file_;
+    uint64_t offset_ = 0;
+    std::vector<tick_store::ChunkEntry> chunks_;
+    std::vector<SymbolId> symbols_;                    // Store index -> symbol
+    std::unordered_map<SymbolId, uint32_t> symbol_index_;
+    std::vector<int64_t> last_ns_;                     // Per store symbol
+    // Column scratch, reused across chunks
+    std::vector<int64_t> timestamps_;
+    std::vector<double> values_;
+    std::vector<uint8_t> encoded_;
+};
+
+// Read-only view of a store. Thread-safe as long as each thread decodes
+// into its own Buffer.
+class TickStore {
+public:
+    // One chunk's columns, trimmed to the requested range. Columns a chunk
+    // does not store are empty. Valid while the store is alive and the
+    // Buffer it was loaded into is not reused.
+    struct Chunk {
+        SymbolId symbol = kInvalidSymbol;
+        int32_t day = 0;
+        Span<const int64_t> timestamps;  // Epoch nanoseconds
+        Span<const double> prices;
+        Span<const double> open;
+        Span<const double> high;
+        Span<const double> low;
+        Span<const double> volumes;
+
+        size_t size() const { return timestamps.size(); }
+        bool hasBars() const { return !open.empty(); }
+    };
+
+    // Decoded columns; reuse one across load() calls to avoid allocating
+    struct Buffer {
+        std::vector<int64_t> timestamps;
+        std::array<std::vector<double>, tick_store::kColumnCount> values;
+    };
+
+    // Throws std::runtime_error if the file is missing, not a store or
+    // not finished
+    explicit TickStore(const std::string& path);
+
+    const std::vector<SymbolId>& symbols() const { return symbols_; }
+    bool contains(SymbolId symbol) const { return symbol_index_.count(symbol) != 0; }
+    size_t chunkCount() const { return entries_.size(); }
+    size_t tickCount(SymbolId symbol) const;
+
+    // Index entries of symbol's chunks overlapping [start, end], in time
+    // order. Nothing is decoded.
+    Span<const tick_store::ChunkEntry> find(SymbolId symbol, Timestamp start = Timestamp::min(),
+                                            Timestamp end = Timestamp::max()) const;
+
+    // Columns of one chunk, trimmed to [start, end]. Raw columns point into
+    // the mapping; packed ones are decoded into buffer.
+    Chunk load(const tick_store::ChunkEntry& entry, Buffer& buffer, Timestamp start = Timestamp::min(),
+               Timestamp end = Timestamp::max()) const;
+
+    // Appends the ticks of symbol in [start, end] to out as MarketData;
+    // returns how many were appended
+    size_t read(SymbolId symbol, Timestamp start, Timestamp end, std::vector<MarketData>& out) const;
+
+private:
+    struct SymbolRange {
+        size_t begin;
+        size_t end;
+    };
+
+    MappedFile file_;
+    Span<const tick_store::ChunkEntry> entries_;
+    std::vector<SymbolId> symbols_;
+    std::unordered_map<SymbolId, SymbolRange> symbol_index_;
+};
+
+} // namespace trading
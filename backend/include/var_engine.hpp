@@ -0,0 +1,103 @@
+#pragma once
+#include "common/types.hpp"
+#include "common/aligned_allocator.hpp"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace trading {
+
+// Loss estimates in currency units over one sampling interval
+struct VarEstimate {
+    double parametric_var = 0.0;
+    double parametric_cvar = 0.0;
+    double historical_var = 0.0;
+    double historical_cvar = 0.0;
+    size_t samples = 0;  // Return rows behind the estimate; 0 means not enough history
+};
+
+// Return history and exposures behind an estimate, for simulation.
+// returns holds the window's per-interval returns, samples x assets
+// row-major, oldest first.
+struct MarketModel {
+    size_t assets = 0;
+    size_t samples = 0;
+    AlignedVector<double> returns;
+    AlignedVector<double> exposures;
+};
+
+// Inverse of the standard normal CDF (Acklam's rational approximation)
+double inverseNormalCdf(double p);
+
+// Native VaR / CVaR engine. Keeps a ring of per-symbol return rows plus
+// running sums and cross-products, so the covariance is updated in O(n^2)
+// per sample and portfolio VaR needs no matrix rebuild. All matrices are
+// contiguous, row-major and cache-line aligned.
+//
+// Single-threaded: owned and driven by the event loop thread.
+class VarEngine {
+public:
+    struct Options {
+        size_t window = 250;        // Return samples kept
+        size_t max_assets = 256;    // Symbols tracked
+        double confidence = 0.95;
+        std::chrono::milliseconds sample_interval{1000};
+    };
+
+    VarEngine();
+    explicit VarEngine(const Options& options);
+
+    // Latest price for a symbol; returns false once max_assets is reached
+    bool onPrice(SymbolId symbol, double price);
+    // Current market value held in a symbol (signed)
+    bool setExposure(SymbolId symbol, double market_value);
+
+    // Closes a return interval: one return per tracked symbol since the
+    // previous sample. Symbols without a price in both samples get 0; the
+    // first call only records starting prices.
+    void sampleReturns();
+    // Samples if at least sample_interval has passed since the last sample
+    bool sampleIfDue(std::chrono::steady_clock::time_point now);
+
+    // Parametric (variance-covariance) and historical estimates for the
+    // current exposures. O(n^2 + window * n), allocation-free.
+    VarEstimate evaluate();
+
+    // Copies the window's returns, oldest first, and current exposures
+    void buildModel(MarketModel& model) const;
+
+    size_t getAssetCount() const { return assets_; }
+    size_t getSampleCount() const { return count_; }
+    double getConfidence() const { return options_.confidence; }
+
+private:
+    static constexpr uint32_t kNoColumn = UINT32_MAX;
+
+    uint32_t columnFor(SymbolId symbol);
+    void rebuildSums();
+    double* row(size_t index) { return returns_.data() + index * stride_; }
+    const double* row(size_t index) const { return returns_.data() + index * stride_; }
+
+    Options options_;
+    size_t stride_;           // max_assets rounded up to a cache line of doubles
+    double z_;                // Normal quantile for the confidence level
+    double tail_density_;     // phi(z) / (1 - confidence), for parametric CVaR
+    size_t assets_ = 0;
+    std::vector<uint32_t> column_of_;  // SymbolId -> column
+
+    AlignedVector<double> prices_;          // Latest price per column
+    AlignedVector<double> sampled_prices_;  // Price at the previous sample
+    AlignedVector<double> exposures_;
+    AlignedVector<double> returns_;         // window x stride ring, oldest at head_
+    AlignedVector<double> sums_;            // Per-column sum of returns in the window
+    AlignedVector<double> cross_;           // stride x stride sum of r_i * r_j
+    AlignedVector<double> scratch_;         // Matvec / historical P&L workspace
+    size_t head_ = 0;
+    size_t count_ = 0;
+    size_t samples_since_rebuild_ = 0;
+    bool primed_ = false;
+    bool full_warned_ = false;
+    std::chrono::steady_clock::time_point last_sample_{};
+};
+
+} // namespace trading
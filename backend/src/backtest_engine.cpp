@@ -0,0 +1,169 @@
+#include "backtest_engine.hpp"
+#include "historical_stream.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace trading {
+
+namespace {
+    OrderExecutor::Options executorOptions() {
+        OrderExecutor::Options options;
+        options.multi_producer = false;  // Only the replay thread submits
+        options.status_retention = 1024;
+        return options;
+    }
+}
+
+BacktestEngine::BacktestEngine(Strategy& strategy, const Options& options)
+    : strategy_(strategy)
+    , options_(options)
+    , order_pool_(options.order_pool_capacity)
+    , portfolio_(options.initial_capital)
+    , risk_manager_(options.limits, &price_table_) {
+    options_.exchange.simulated_clock = true;
+}
+
+BacktestResult BacktestEngine::run(Span<const MarketData> ticks) {
+    begin();
+    for (const MarketData& tick : ticks) {
+        onTick(tick);
+    }
+    return finish();
+}
+
+BacktestResult BacktestEngine::run(HistoricalStream& stream) {
+    begin();
+    for (Span<const MarketData> batch = stream.next(); !batch.empty(); batch = stream.next()) {
+        for (const MarketData& tick : batch) {
+            onTick(tick);
+        }
+    }
+    return finish();
+}
+
+void BacktestEngine::begin() {
+    portfolio_ = Portfolio(options_.initial_capital);
+    auto exchange = std::make_unique<SimulatedExchange>(options_.exchange);
+    exchange_ = exchange.get();
+    executor_ = std::make_unique<OrderExecutor>(order_pool_, executorOptions());
+    executor_->setVenue(std::move(exchange));
+    executor_->setUpdateHandler([this](Span<const OrderUpdate> updates) { onUpdates(updates); });
+
+    result_ = BacktestResult();
+    result_.initial_capital = options_.initial_capital;
+    next_equity_ = Timestamp();
+    last_tick_ = Timestamp();
+    strategy_.initialize();
+    started_ = std::chrono::steady_clock::now();
+}
+
+void BacktestEngine::onTick(const MarketData& tick) {
+    ++result_.events;
+    last_tick_ = tick.timestamp;
+    price_table_.update(tick);
+
+    // Resting orders and requests in flight see the trade first, so the
+    // strategy observes its own fills before the tick that caused them
+    exchange_->onTrade(tick.symbol_id, tick.last_price, tick.volume, tick.timestamp);
+    executor_->drain();
+
+    portfolio_.advanceClock(tick.timestamp);
+    portfolio_.markPrice(tick.symbol_id, tick.last_price);
+    result_.max_drawdown = std::max(result_.max_drawdown, portfolio_.getDrawdown());
+    processSignals(strategy_.onMarketData(tick));
+
+    if (options_.equity_interval.count() > 0 && tick.timestamp >= next_equity_) {
+        recordEquity(tick.timestamp);
+        next_equity_ = tick.timestamp +
+                       std::chrono::duration_cast<Timestamp::duration>(options_.equity_interval);
+    }
+}
+
+BacktestResult BacktestEngine::finish() {
+    // Deliver whatever is still in flight
+    if (exchange_) {
+        exchange_->advanceTo(Timestamp::max());
+        executor_->drain();
+    }
+    if (options_.equity_interval.count() > 0 && result_.events > 0) {
+        recordEquity(last_tick_);
+    }
+
+    result_.final_value = portfolio_.getTotalValue();
+    result_.total_return = result_.initial_capital > 0.0
+        ? (result_.final_value - result_.initial_capital) / result_.initial_capital : 0.0;
+    result_.realized_pnl = portfolio_.getRealizedPnL();
+    result_.elapsed_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started_).count();
+
+    executor_.reset();
+    exchange_ = nullptr;
+    spdlog::debug("Backtest finished: {} events in {:.2f}s ({:.1f}M/s), {} fills, return {:.2f}%",
+                 result_.events, result_.elapsed_seconds,
+                 result_.elapsed_seconds > 0.0 ? result_.events / result_.elapsed_seconds / 1e6 : 0.0,
+                 result_.fills, result_.total_return * 100.0);
+    return std::move(result_);
+}
+
+void BacktestEngine::onUpdates(Span<const OrderUpdate> updates) {
+    for (const OrderUpdate& update : updates) {
+        const Order& order = update.order;
+        if (update.fill_quantity > 0.0) {
+            double commission = std::abs(update.fill_quantity * update.fill_price) * options_.commission_rate;
+            double quantity = order.getSide() == OrderSide::BUY ? update.fill_quantity : -update.fill_quantity;
+            portfolio_.applyFill(order.getSymbol(), quantity, update.fill_price, commission);
+            ++result_.fills;
+            result_.commission += commission;
+            if (options_.record_trades) {
+                result_.trades.push_back(TradeRecord{order.getUpdateTime(), order.getSymbol(), order.getSide(),
+                                                     update.fill_quantity, update.fill_price, commission,
+                                                     order.getOrderId()});
+            }
+        }
+        strategy_.onOrderUpdate(order);
+    }
+}
+
+void BacktestEngine::processSignals(const std::vector<Strategy::Signal>& signals) {
+    if (signals.empty()) {
+        return;
+    }
+    pending_orders_.clear();
+    for (const auto& signal : signals) {
+        double quantity = signalOrderQuantity(signal, price_table_.getLastPrice(signal.symbol),
+                                              portfolio_.getTotalValue(), options_.position_size_limit);
+        if (quantity <= 0.0) {
+            continue;
+        }
+        Order* order = order_pool_.acquire(signal.symbol, signal.side, OrderType::MARKET, quantity);
+        if (!order) {
+            spdlog::error("Backtest order pool exhausted");
+            break;
+        }
+        pending_orders_.push_back(order);
+    }
+
+    pending_verdicts_.resize(pending_orders_.size());
+    risk_manager_.checkOrderBatch({pending_orders_.data(), pending_orders_.size()}, portfolio_,
+                                  pending_verdicts_);
+    for (size_t i = 0; i < pending_orders_.size(); ++i) {
+        Order* order = pending_orders_[i];
+        if (!pending_verdicts_[i]) {
+            ++result_.orders_rejected;
+            order_pool_.release(order);
+        } else if (executor_->submitOrder(order)) {
+            ++result_.orders_submitted;
+        } else {
+            order_pool_.release(order);
+        }
+    }
+    executor_->drain();
+}
+
+void BacktestEngine::recordEquity(Timestamp now) {
+    result_.equity_curve.push_back(EquityPoint{now, portfolio_.getTotalValue(), portfolio_.getCash(),
+                                               portfolio_.getDrawdown()});
+}
+
+} // namespace trading
@@ -1,17 +1,63 @@
 #include "data_loader.hpp"
+#include <pybind11/embed.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/chrono.h>
 #include <pybind11/stl.h>
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <utility>
 
 namespace py = pybind11;
 
 namespace trading {
 
+// Layout must match QUOTE_DTYPE in data_service/fetchers/yahoo_fetcher.py
+struct PyQuoteRecord {
+    int32_t symbol_index;
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+    int64_t timestamp_ns;
+};
+
+} // namespace trading
+
+PYBIND11_NUMPY_DTYPE(trading::PyQuoteRecord,
+    symbol_index, open, high, low, close, volume, timestamp_ns);
+
+namespace trading {
+
+namespace {
+    using QuoteArray = py::array_t<PyQuoteRecord, py::array::c_style>;
+
+    MarketData convertQuote(const PyQuoteRecord& record, SymbolId symbol_id) {
+        MarketData market_data;
+        market_data.symbol_id = symbol_id;
+        market_data.last_price = record.close;
+        market_data.open = record.open;
+        market_data.high = record.high;
+        market_data.low = record.low;
+        market_data.volume = record.volume;
+        market_data.timestamp = fromEpochNanos(record.timestamp_ns);
+        return market_data;
+    }
+}
+
+// The GIL is held only inside calls into Python. Everything else in the
+// engine runs without it, so Python threads (e.g. websocket callbacks)
+// and C++ threads never serialize on each other.
 class DataLoader::Impl {
 public:
     Impl() {
+        if (!Py_IsInitialized()) {
+            interpreter_ = std::make_unique<py::scoped_interpreter>();
+        }
+
         try {
+            py::gil_scoped_acquire gil;
             // Initialize Python interface
             py::module::import("sys").attr("path").attr("append")("../");
             data_service_ = py::module::import("data_service");
@@ -21,12 +67,25 @@ public:
             spdlog::error("Failed to initialize Python interface: {}", e.what());
             throw;
         }
+
+        if (interpreter_) {
+            gil_release_ = std::make_unique<py::gil_scoped_release>();
+        }
+    }
+
+    ~Impl() {
+        // Re-acquire the GIL before dropping Python references
+        gil_release_.reset();
+        py::gil_scoped_acquire gil;
+        fetcher_ = py::object();
+        data_service_ = py::module();
     }
 
-    MarketData loadMarketData(const std::string& symbol) {
+    MarketData loadMarketData(const std::string& symbol, MarketDataExtras* extras) {
         try {
+            py::gil_scoped_acquire gil;
             py::object data = fetcher_.attr("get_current_price")(symbol);
-            return convertPyToMarketData(data, symbol);
+            return convertPyToMarketData(data, internSymbol(symbol), extras);
             
         } catch (const std::exception& e) {
             spdlog::error("Failed to load market data for {}: {}", symbol, e.what());
@@ -40,15 +99,23 @@ public:
         const Timestamp& end
     ) {
         try {
-            py::object data = fetcher_.attr("fetch_historical_data")(
+            SymbolId symbol_id = internSymbol(symbol);
+            std::vector<MarketData> result;
+
+            py::gil_scoped_acquire gil;
+            QuoteArray quotes = fetcher_.attr("fetch_historical_array")(
                 symbol,
                 py::cast(start),
                 py::cast(end)
             );
-            
-            std::vector<MarketData> result;
-            for (const auto& item : data) {
-                result.push_back(convertPyToMarketData(item, symbol));
+            const PyQuoteRecord* records = quotes.data();
+            size_t count = static_cast<size_t>(quotes.size());
+
+            // quotes keeps the buffer alive; no Python objects are touched below
+            py::gil_scoped_release release;
+            result.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                result.push_back(convertQuote(records[i], symbol_id));
             }
             return result;
             
@@ -58,13 +125,52 @@ public:
         }
     }
 
+    void loadMarketDataBatch(const std::vector<SymbolId>& symbols, std::vector<MarketData>& out) {
+        out.clear();
+        if (symbols.empty()) {
+            return;
+        }
+
+        try {
+            py::gil_scoped_acquire gil;
+            py::list names(symbols.size());
+            for (size_t i = 0; i < symbols.size(); ++i) {
+                names[i] = py::str(symbolName(symbols[i]));
+            }
+
+            // One Python round trip for the whole universe
+            QuoteArray quotes = fetcher_.attr("get_quotes_array")(names);
+            const PyQuoteRecord* records = quotes.data();
+            size_t count = static_cast<size_t>(quotes.size());
+
+            // Zero-copy read of the NumPy buffer with the GIL released
+            py::gil_scoped_release release;
+            out.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                auto index = static_cast<size_t>(records[i].symbol_index);
+                if (index < symbols.size()) {
+                    out.push_back(convertQuote(records[i], symbols[index]));
+                }
+            }
+
+        } catch (const std::exception& e) {
+            spdlog::error("Failed to load market data batch of {} symbols: {}", symbols.size(), e.what());
+            throw;
+        }
+    }
+
     void subscribeToRealTimeData(
         const std::string& symbol,
         std::function<void(const MarketData&)> callback
     ) {
         try {
+            py::gil_scoped_acquire gil;
             auto py_callback = [callback](const py::object& data) {
-                callback(convertPyToMarketData(data, data.attr("symbol").cast<std::string>()));
+                SymbolId symbol_id = internSymbol(data.attr("symbol").cast<std::string>());
+                MarketData market_data = convertPyToMarketData(data, symbol_id, nullptr);
+                // Engine code never needs the GIL
+                py::gil_scoped_release release;
+                callback(market_data);
             };
             
             fetcher_.attr("start_websocket")(symbol, py_callback);
@@ -76,9 +182,13 @@ public:
     }
 
 private:
-    static MarketData convertPyToMarketData(const py::object& data, const std::string& symbol) {
+    static MarketData convertPyToMarketData(
+        const py::object& data,
+        SymbolId symbol_id,
+        MarketDataExtras* extras
+    ) {
         MarketData market_data;
-        market_data.symbol = symbol;
+        market_data.symbol_id = symbol_id;
         market_data.last_price = data.attr("close").cast<double>();
         market_data.open = data.attr("open").cast<double>();
         market_data.high = data.attr("high").cast<double>();
@@ -86,29 +196,43 @@ private:
         market_data.volume = data.attr("volume").cast<double>();
         market_data.timestamp = data.attr("timestamp").cast<Timestamp>();
         
-        // Convert technical indicators
+        // Convert technical indicators into fixed slots, spilling the rest
         if (py::hasattr(data, "indicators")) {
             py::dict indicators = data.attr("indicators");
             for (const auto& item : indicators) {
                 std::string key = item.first.cast<std::string>();
                 double value = item.second.cast<double>();
-                market_data.indicators[key] = value;
+                IndicatorId id = indicatorFromName(key);
+                if (id != IndicatorId::COUNT) {
+                    market_data.setIndicator(id, value);
+                } else if (extras) {
+                    extras->indicators[key] = value;
+                }
+            }
+        }
+
+        if (extras && py::hasattr(data, "fundamentals")) {
+            py::dict fundamentals = data.attr("fundamentals");
+            for (const auto& item : fundamentals) {
+                extras->fundamentals[item.first.cast<std::string>()] = item.second.cast<double>();
             }
         }
         
         return market_data;
     }
 
+    std::unique_ptr<py::scoped_interpreter> interpreter_;  // Set when we own the interpreter
     py::module data_service_;
     py::object fetcher_;
+    std::unique_ptr<py::gil_scoped_release> gil_release_;
 };
 
 // Implementation of DataLoader class
 DataLoader::DataLoader() : pimpl_(std::make_unique<Impl>()) {}
 DataLoader::~DataLoader() = default;
 
-MarketData DataLoader::loadMarketData(const std::string& symbol) {
-    return pimpl_->loadMarketData(symbol);
+MarketData DataLoader::loadMarketData(const std::string& symbol, MarketDataExtras* extras) {
+    return pimpl_->loadMarketData(symbol, extras);
 }
 
 std::vector<MarketData> DataLoader::loadHistoricalData(
@@ -119,6 +243,28 @@ std::vector<MarketData> DataLoader::loadHistoricalData(
     return pimpl_->loadHistoricalData(symbol, start, end);
 }
 
+std::unique_ptr<HistoricalStream> DataLoader::openHistoricalStream(
+    const std::string& path,
+    const std::vector<std::string>& symbols,
+    const Timestamp& start,
+    const Timestamp& end,
+    const HistoricalStream::Options& options
+) {
+    std::vector<SymbolId> ids;
+    ids.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        ids.push_back(internSymbol(symbol));
+    }
+    return std::make_unique<HistoricalStream>(path, std::move(ids), start, end, options);
+}
+
+void DataLoader::loadMarketDataBatch(
+    const std::vector<SymbolId>& symbols,
+    std::vector<MarketData>& out
+) {
+    pimpl_->loadMarketDataBatch(symbols, out);
+}
+
 void DataLoader::subscribeToRealTimeData(
     const std::string& symbol,
     std::function<void(const MarketData&)> callback
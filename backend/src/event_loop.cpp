@@ -0,0 +1,98 @@
+#include "event_loop.hpp"
+#include <spdlog/spdlog.h>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace trading {
+
+namespace {
+    // Upper bound on events handled between housekeeping checks
+    constexpr size_t kMaxEventsPerIteration = 1024;
+}
+
+EventLoop::EventLoop() : EventLoop(Options()) {}
+
+EventLoop::EventLoop(const Options& options)
+    : options_(options)
+    , running_(false)
+    , stop_requested_(false)
+    , queue_(options.queue_capacity)
+    , waiter_(options.busy_spin ? WaitStrategy::SPIN : WaitStrategy::BLOCK) {
+}
+
+void EventLoop::post(const MarketData& data) {
+    post(EngineEvent(data));
+}
+
+void EventLoop::post(const OrderUpdate& update) {
+    post(EngineEvent(update));
+}
+
+void EventLoop::post(EngineEvent event) {
+    while (!queue_.tryPush(event)) {
+        std::this_thread::yield();
+    }
+    waiter_.notify();
+}
+
+void EventLoop::run(const EventHandler& on_event, const HousekeepingHandler& on_housekeeping) {
+    pinToCore();
+    running_.store(true, std::memory_order_release);
+    spdlog::info("Event loop started ({} mode)", options_.busy_spin ? "busy-spin" : "blocking");
+
+    EngineEvent event;
+    auto next_housekeeping = std::chrono::steady_clock::now() + options_.housekeeping_interval;
+
+    while (!stop_requested_.load(std::memory_order_acquire)) {
+        size_t handled = 0;
+        while (handled < kMaxEventsPerIteration && queue_.tryPop(event)) {
+            on_event(event);
+            ++handled;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_housekeeping) {
+            on_housekeeping();
+            next_housekeeping = now + options_.housekeeping_interval;
+        }
+
+        if (handled == 0) {
+            waiter_.waitUntil([this] {
+                return !queue_.empty() || stop_requested_.load(std::memory_order_acquire);
+            }, next_housekeeping);
+        }
+    }
+
+    running_.store(false, std::memory_order_release);
+    spdlog::info("Event loop stopped");
+}
+
+void EventLoop::stop() {
+    stop_requested_.store(true, std::memory_order_release);
+    waiter_.notify();
+}
+
+void EventLoop::pinToCore() {
+    if (options_.cpu_core < 0) {
+        return;
+    }
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(options_.cpu_core, &cpuset);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    if (rc != 0) {
+        spdlog::warn("Failed to pin event loop to core {}: error {}", options_.cpu_core, rc);
+    } else {
+        spdlog::info("Event loop pinned to core {}", options_.cpu_core);
+    }
+#else
+    spdlog::warn("CPU pinning is not supported on this platform");
+#endif
+}
+
+} // namespace trading
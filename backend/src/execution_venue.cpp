@@ -0,0 +1,99 @@
+#include "execution_venue.hpp"
+
+namespace trading {
+
+namespace {
+    // Whether an order would trade against the last price right now
+    bool isMarketable(const Order& order, double last_price) {
+        bool buy = order.getSide() == OrderSide::BUY;
+        bool stop_triggered = buy ? last_price >= order.getStopPrice()
+                                  : last_price <= order.getStopPrice();
+        bool limit_crosses = buy ? last_price <= order.getPrice() : last_price >= order.getPrice();
+        switch (order.getType()) {
+            case OrderType::MARKET: return true;
+            case OrderType::LIMIT: return limit_crosses;
+            case OrderType::STOP: return stop_triggered;
+            case OrderType::STOP_LIMIT: return stop_triggered && limit_crosses;
+        }
+        return false;
+    }
+
+    ExecutionReport fillAt(const Order& order, double last_price) {
+        ExecutionReport execution;
+        execution.type = ExecutionReport::Type::FILL;
+        execution.order_id = order.getOrderId();
+        execution.quantity = order.getRemainingQuantity();
+        execution.price = last_price;
+        execution.timestamp = std::chrono::system_clock::now();
+        return execution;
+    }
+}
+
+void ImmediateFillVenue::submit(const Order& order) {
+    double last_price = prices_ ? prices_->getLastPrice(order.getSymbol()) : order.getPrice();
+    if (last_price <= 0.0) {
+        ExecutionReport execution;
+        execution.type = ExecutionReport::Type::REJECTED;
+        execution.order_id = order.getOrderId();
+        execution.timestamp = std::chrono::system_clock::now();
+        report(execution);
+        return;
+    }
+    if (!isMarketable(order, last_price)) {
+        resting_.insert_or_assign(order.getOrderId(), order);
+        return;
+    }
+    report(fillAt(order, last_price));
+}
+
+void ImmediateFillVenue::poll() {
+    // Without a price table the last price never moves
+    if (!prices_) {
+        return;
+    }
+    for (auto it = resting_.begin(); it != resting_.end();) {
+        double last_price = prices_->getLastPrice(it->second.getSymbol());
+        if (last_price <= 0.0 || !isMarketable(it->second, last_price)) {
+            ++it;
+            continue;
+        }
+        ExecutionReport execution = fillAt(it->second, last_price);
+        it = resting_.erase(it);
+        report(execution);
+    }
+}
+
+void ImmediateFillVenue::cancel(OrderId order_id) {
+    if (resting_.erase(order_id) == 0) {
+        return;
+    }
+    ExecutionReport execution;
+    execution.type = ExecutionReport::Type::CANCELLED;
+    execution.order_id = order_id;
+    execution.timestamp = std::chrono::system_clock::now();
+    report(execution);
+}
+
+void ImmediateFillVenue::replace(OrderId order_id, double quantity, double price) {
+    auto it = resting_.find(order_id);
+    if (it == resting_.end()) {
+        return;
+    }
+    Order order = it->second;
+    resting_.erase(it);
+    order.setQuantity(quantity);
+    order.setPrice(price);
+
+    ExecutionReport execution;
+    execution.type = ExecutionReport::Type::REPLACED;
+    execution.order_id = order_id;
+    execution.quantity = quantity;
+    execution.price = price;
+    execution.timestamp = std::chrono::system_clock::now();
+    report(execution);
+
+    // The new terms may now cross
+    submit(order);
+}
+
+} // namespace trading
@@ -0,0 +1,465 @@
+#include "feed_handler.hpp"
+#include <boost/asio.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+
+namespace trading {
+
+namespace asio = boost::asio;
+using asio::ip::tcp;
+
+namespace {
+    size_t formatCsvLine(const MarketData& tick, char* buffer, size_t size) {
+        int written = std::snprintf(buffer, size, "%lld,%s,%.10g,%.10g,%.10g,%.10g,%.10g\n",
+            static_cast<long long>(toEpochNanos(tick.timestamp)),
+            symbolName(tick.symbol_id).c_str(),
+            tick.open, tick.high, tick.low, tick.last_price, tick.volume);
+        return (written > 0 && static_cast<size_t>(written) < size) ? written : 0;
+    }
+}
+
+SymbolId SymbolCache::resolve(const char* name, size_t length) {
+    // Symbols fit the small-string buffer, so the lookup key does not allocate
+    std::string key(name, length);
+    auto it = ids_.find(key);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    SymbolId id = internSymbol(key);
+    ids_.emplace(std::move(key), id);
+    return id;
+}
+
+// CsvReplaySource
+
+CsvReplaySource::CsvReplaySource(std::string path) : path_(std::move(path)), line_(kMaxLineLength + 2) {}
+
+CsvReplaySource::~CsvReplaySource() {
+    close();
+}
+
+void CsvReplaySource::open() {
+    file_ = std::fopen(path_.c_str(), "r");
+    if (!file_) {
+        throw std::runtime_error("Failed to open CSV feed " + path_ + ": " + std::strerror(errno));
+    }
+}
+
+bool CsvReplaySource::next(MarketData& tick) {
+    while (file_ && std::fgets(line_.data(), static_cast<int>(line_.size()), file_)) {
+        size_t length = std::strlen(line_.data());
+        if (length == line_.size() - 1 && line_[length - 1] != '\n') {
+            // fgets stopped mid-line; skip the rest unless the file ends here
+            int c = std::fgetc(file_);
+            if (c != EOF) {
+                while (c != '\n' && c != EOF) {
+                    c = std::fgetc(file_);
+                }
+                spdlog::warn("Skipped a line longer than {} bytes in {}", kMaxLineLength, describe());
+                continue;
+            }
+        }
+        if (parseLine(line_.data(), symbols_, tick)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CsvReplaySource::close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool CsvReplaySource::parseLine(const char* line, SymbolCache& symbols, MarketData& tick) {
+    char* end = nullptr;
+    long long ts = std::strtoll(line, &end, 10);
+    if (end == line || *end != ',') {
+        return false;  // Header or malformed line
+    }
+
+    const char* symbol = end + 1;
+    const char* comma = std::strchr(symbol, ',');
+    if (!comma || comma == symbol) {
+        return false;
+    }
+
+    double fields[5];
+    const char* cursor = comma;
+    for (double& field : fields) {
+        if (*cursor != ',') {
+            return false;
+        }
+        field = std::strtod(cursor + 1, &end);
+        if (end == cursor + 1) {
+            return false;
+        }
+        cursor = end;
+    }
+
+    tick = MarketData();
+    tick.symbol_id = symbols.resolve(symbol, static_cast<size_t>(comma - symbol));
+    tick.timestamp = fromEpochNanos(ts);
+    tick.open = fields[0];
+    tick.high = fields[1];
+    tick.low = fields[2];
+    tick.last_price = fields[3];
+    tick.volume = fields[4];
+    return true;
+}
+
+// BinaryReplaySource
+
+BinaryReplaySource::BinaryReplaySource(std::string path, size_t block_records)
+    : path_(std::move(path)), block_(block_records) {}
+
+BinaryReplaySource::~BinaryReplaySource() {
+    close();
+}
+
+void BinaryReplaySource::open() {
+    file_ = std::fopen(path_.c_str(), "rb");
+    if (!file_) {
+        throw std::runtime_error("Failed to open binary feed " + path_ + ": " + std::strerror(errno));
+    }
+    block_size_ = 0;
+    block_pos_ = 0;
+}
+
+bool BinaryReplaySource::next(MarketData& tick) {
+    if (block_pos_ == block_size_) {
+        if (!file_) {
+            return false;
+        }
+        block_size_ = std::fread(block_.data(), sizeof(TickRecord), block_.size(), file_);
+        block_pos_ = 0;
+        if (block_size_ == 0) {
+            return false;
+        }
+    }
+
+    const TickRecord& record = block_[block_pos_++];
+    tick = MarketData();
+    tick.symbol_id = symbols_.resolve(record.symbol, strnlen(record.symbol, sizeof(record.symbol)));
+    tick.timestamp = fromEpochNanos(record.timestamp_ns);
+    tick.open = record.open;
+    tick.high = record.high;
+    tick.low = record.low;
+    tick.last_price = record.close;
+    tick.volume = record.volume;
+    return true;
+}
+
+void BinaryReplaySource::close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+// BinaryTickWriter
+
+BinaryTickWriter::BinaryTickWriter(const std::string& path) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        throw std::runtime_error("Failed to create tick file " + path + ": " + std::strerror(errno));
+    }
+}
+
+BinaryTickWriter::~BinaryTickWriter() {
+    close();
+}
+
+void BinaryTickWriter::write(const MarketData& tick) {
+    TickRecord record{};
+    record.timestamp_ns = toEpochNanos(tick.timestamp);
+    const std::string& name = symbolName(tick.symbol_id);
+    std::strncpy(record.symbol, name.c_str(), sizeof(record.symbol) - 1);
+    record.open = tick.open;
+    record.high = tick.high;
+    record.low = tick.low;
+    record.close = tick.last_price;
+    record.volume = tick.volume;
+    if (std::fwrite(&record, sizeof(record), 1, file_) != 1) {
+        throw std::runtime_error("Failed to write tick record");
+    }
+}
+
+void BinaryTickWriter::close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+// TcpFeedSource
+
+class TcpFeedSource::Connection {
+public:
+    Connection() : socket(io), buffer(CsvReplaySource::kMaxLineLength + 2) {}
+
+    asio::io_context io;
+    tcp::socket socket;
+    asio::streambuf buffer;  // Bounded, so a peer that never sends '\n' cannot grow it
+};
+
+TcpFeedSource::TcpFeedSource(std::string host, uint16_t port)
+    : host_(std::move(host)), port_(port) {}
+
+TcpFeedSource::~TcpFeedSource() {
+    close();
+}
+
+void TcpFeedSource::open() {
+    connection_ = std::make_unique<Connection>();
+    tcp::resolver resolver(connection_->io);
+    asio::connect(connection_->socket, resolver.resolve(host_, std::to_string(port_)));
+    connection_->socket.set_option(tcp::no_delay(true));
+    spdlog::info("Connected to feed {}", describe());
+}
+
+bool TcpFeedSource::next(MarketData& tick) {
+    if (!connection_) {
+        return false;
+    }
+
+    boost::system::error_code ec;
+    bool skipping = false;  // Dropping the rest of an over-long line
+    for (;;) {
+        size_t length = asio::read_until(connection_->socket, connection_->buffer, '\n', ec);
+        if (ec == asio::error::not_found) {
+            // The buffer filled without a newline
+            if (!skipping) {
+                spdlog::warn("Feed {} skipped a line over {} bytes", describe(), connection_->buffer.size());
+                skipping = true;
+            }
+            connection_->buffer.consume(connection_->buffer.size());
+            continue;
+        }
+        if (ec) {
+            if (ec != asio::error::eof) {
+                spdlog::warn("Feed {} read failed: {}", describe(), ec.message());
+            }
+            return false;
+        }
+        if (skipping) {
+            connection_->buffer.consume(length);
+            skipping = false;
+            continue;
+        }
+
+        // The line is contiguous in the streambuf's input sequence
+        char line[CsvReplaySource::kMaxLineLength + 2];
+        if (length > sizeof(line) - 1) {
+            connection_->buffer.consume(length);
+            spdlog::warn("Feed {} skipped a {}-byte line", describe(), length);
+            continue;
+        }
+        const char* data = static_cast<const char*>(connection_->buffer.data().data());
+        std::memcpy(line, data, length);
+        line[length] = '\0';
+        connection_->buffer.consume(length);
+        if (CsvReplaySource::parseLine(line, symbols_, tick)) {
+            return true;
+        }
+    }
+}
+
+void TcpFeedSource::close() {
+    if (connection_) {
+        boost::system::error_code ec;
+        connection_->socket.close(ec);
+        connection_.reset();
+    }
+}
+
+void TcpFeedSource::interrupt() {
+    if (connection_) {
+        ::shutdown(connection_->socket.native_handle(), SHUT_RDWR);
+    }
+}
+
+std::string TcpFeedSource::describe() const {
+    return "tcp:" + host_ + ":" + std::to_string(port_);
+}
+
+// FeedReplayServer
+
+class FeedReplayServer::Acceptor {
+public:
+    explicit Acceptor(uint16_t port)
+        : acceptor(io, tcp::endpoint(asio::ip::address_v4::loopback(), port)) {}
+
+    asio::io_context io;
+    tcp::acceptor acceptor;
+};
+
+FeedReplayServer::FeedReplayServer(std::unique_ptr<MarketDataSource> source, uint16_t port)
+    : source_(std::move(source)), port_(port), running_(false) {}
+
+FeedReplayServer::~FeedReplayServer() {
+    stop();
+}
+
+void FeedReplayServer::start() {
+    acceptor_ = std::make_unique<Acceptor>(port_);
+    port_ = acceptor_->acceptor.local_endpoint().port();
+    running_ = true;
+    thread_ = std::thread(&FeedReplayServer::serveLoop, this);
+    spdlog::info("Feed replay server serving {} on port {}", source_->describe(), port_);
+}
+
+void FeedReplayServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    // Unblocks accept() and any in-flight write
+    ::shutdown(acceptor_->acceptor.native_handle(), SHUT_RDWR);
+    {
+        std::lock_guard<std::mutex> lock(client_mutex_);
+        if (client_fd_ >= 0) {
+            ::shutdown(client_fd_, SHUT_RDWR);
+        }
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    acceptor_.reset();
+}
+
+void FeedReplayServer::serveLoop() {
+    char line[256];
+    while (running_) {
+        boost::system::error_code ec;
+        tcp::socket client(acceptor_->io);
+        acceptor_->acceptor.accept(client, ec);
+        if (ec) {
+            break;
+        }
+        client.set_option(tcp::no_delay(true), ec);
+        {
+            // Registered before running_ is re-checked, so a concurrent
+            // stop() either sees the socket or ends the loop below
+            std::lock_guard<std::mutex> lock(client_mutex_);
+            client_fd_ = client.native_handle();
+        }
+
+        try {
+            source_->open();
+            MarketData tick;
+            while (running_ && source_->next(tick)) {
+                size_t length = formatCsvLine(tick, line, sizeof(line));
+                if (length == 0) {
+                    continue;
+                }
+                asio::write(client, asio::buffer(line, length), ec);
+                if (ec) {
+                    break;
+                }
+            }
+            source_->close();
+        } catch (const std::exception& e) {
+            spdlog::error("Feed replay server error: {}", e.what());
+            source_->close();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(client_mutex_);
+            client_fd_ = -1;
+        }
+        client.shutdown(tcp::socket::shutdown_both, ec);
+    }
+}
+
+// Factory
+
+std::unique_ptr<MarketDataSource> makeMarketDataSource(const FeedConfig& config) {
+    if (config.source == "csv") {
+        return std::make_unique<CsvReplaySource>(config.path);
+    }
+    if (config.source == "binary") {
+        return std::make_unique<BinaryReplaySource>(config.path);
+    }
+    if (config.source == "tcp") {
+        return std::make_unique<TcpFeedSource>(config.host, config.port);
+    }
+    throw std::invalid_argument("No native market data source for type " + config.source);
+}
+
+// FeedHandler
+
+FeedHandler::FeedHandler(std::unique_ptr<MarketDataSource> source, TickCallback callback,
+                         bool pace, double speed)
+    : source_(std::move(source))
+    , callback_(std::move(callback))
+    , pace_(pace)
+    , speed_(speed > 0.0 ? speed : 1.0)
+    , running_(false)
+    , ticks_decoded_(0) {
+}
+
+FeedHandler::~FeedHandler() {
+    stop();
+}
+
+void FeedHandler::start() {
+    source_->open();
+    running_ = true;
+    io_thread_ = std::thread(&FeedHandler::ioLoop, this);
+    spdlog::info("Feed handler started on {}", source_->describe());
+}
+
+void FeedHandler::stop() {
+    {
+        // Under the lock so a paced wait cannot miss the wakeup
+        std::lock_guard<std::mutex> lock(pace_mutex_);
+        running_ = false;
+    }
+    pace_wake_.notify_all();
+    source_->interrupt();
+    if (io_thread_.joinable()) {
+        io_thread_.join();
+        source_->close();
+        spdlog::info("Feed handler stopped after {} ticks", getTicksDecoded());
+    }
+}
+
+void FeedHandler::ioLoop() {
+    MarketData tick;
+    Timestamp first_tick{};
+    auto replay_start = std::chrono::steady_clock::now();
+
+    try {
+        while (running_ && source_->next(tick)) {
+            if (pace_) {
+                if (ticks_decoded_.load(std::memory_order_relaxed) == 0) {
+                    first_tick = tick.timestamp;
+                    replay_start = std::chrono::steady_clock::now();
+                }
+                auto offset = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    (tick.timestamp - first_tick) / speed_);
+                std::unique_lock<std::mutex> lock(pace_mutex_);
+                if (pace_wake_.wait_until(lock, replay_start + offset, [this] { return !running_; })) {
+                    break;
+                }
+            }
+
+            callback_(tick);
+            ticks_decoded_.fetch_add(1, std::memory_order_relaxed);
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("Feed handler error on {}: {}", source_->describe(), e.what());
+    }
+
+    running_ = false;
+    spdlog::info("Feed {} finished", source_->describe());
+}
+
+} // namespace trading
@@ -0,0 +1,160 @@
+#include "historical_stream.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace trading {
+
+HistoricalStream::HistoricalStream(const std::string& path, std::vector<SymbolId> symbols, Timestamp start,
+                                   Timestamp end, const Options& options)
+    : store_(path), symbols_(std::move(symbols)), start_(start), end_(end), options_(options) {
+    if (options_.batch_size == 0) {
+        throw std::invalid_argument("HistoricalStream batch_size must be positive");
+    }
+
+    cursors_.reserve(symbols_.size());
+    for (size_t i = 0; i < symbols_.size(); ++i) {
+        if (!store_.contains(symbols_[i])) {
+            spdlog::warn("Tick store {} has no data for {}", path, symbolName(symbols_[i]));
+            continue;
+        }
+        Cursor cursor;
+        cursor.order = i;
+        cursor.entries = store_.find(symbols_[i], start_, end_);
+        cursors_.push_back(std::move(cursor));
+    }
+
+    slots_.resize(options_.prefetch + 1);
+    for (auto& slot : slots_) {
+        slot.reserve(options_.batch_size);
+    }
+    producer_ = std::thread(&HistoricalStream::produce, this);
+}
+
+HistoricalStream::~HistoricalStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    space_.notify_one();
+    producer_.join();
+}
+
+Span<const MarketData> HistoricalStream::next() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (holding_) {
+        holding_ = false;
+        ++released_;
+        space_.notify_one();
+    }
+    ready_.wait(lock, [this] { return taken_ < published_ || finished_; });
+    if (taken_ < published_) {
+        holding_ = true;
+        return slots_[taken_++ % slots_.size()];
+    }
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+    return {};
+}
+
+void HistoricalStream::produce() {
+    try {
+        for (Cursor& cursor : cursors_) {
+            if (advance(cursor)) {
+                heap_.push_back(&cursor);
+            }
+        }
+        std::make_heap(heap_.begin(), heap_.end(), later);
+
+        while (!heap_.empty()) {
+            size_t slot;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                space_.wait(lock, [this] { return stop_ || published_ - released_ < slots_.size(); });
+                if (stop_) {
+                    return;
+                }
+                slot = published_ % slots_.size();
+            }
+
+            // Decoded without the lock; the consumer never touches this slot
+            std::vector<MarketData>& batch = slots_[slot];
+            batch.clear();
+            fill(batch);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++published_;
+            }
+            ready_.notify_one();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+    }
+    ready_.notify_one();
+}
+
+void HistoricalStream::fill(std::vector<MarketData>& batch) {
+    while (batch.size() < options_.batch_size && !heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        Cursor& cursor = *heap_.back();
+        heap_.pop_back();
+
+        // Copy the run of rows that sort before the next cursor in one go.
+        // The popped cursor is the earliest, so the run is never empty.
+        const TickStore::Chunk& chunk = cursor.chunk;
+        const int64_t* first = chunk.timestamps.data() + cursor.row;
+        const int64_t* last = first + std::min(chunk.size() - cursor.row, options_.batch_size - batch.size());
+        if (!heap_.empty()) {
+            const Cursor& next = *heap_.front();
+            last = cursor.order < next.order ? std::upper_bound(first, last, next.time())
+                                             : std::lower_bound(first, last, next.time());
+        }
+
+        size_t rows = static_cast<size_t>(last - first);
+        size_t offset = batch.size();
+        batch.resize(offset + rows);
+        for (size_t i = 0; i < rows; ++i) {
+            size_t row = cursor.row + i;
+            MarketData& tick = batch[offset + i];
+            tick.symbol_id = chunk.symbol;
+            tick.timestamp = fromEpochNanos(chunk.timestamps[row]);
+            tick.last_price = chunk.prices[row];
+            tick.volume = chunk.volumes[row];
+            if (chunk.hasBars()) {
+                tick.open = chunk.open[row];
+                tick.high = chunk.high[row];
+                tick.low = chunk.low[row];
+            }
+        }
+        cursor.row += rows;
+
+        if (cursor.row < chunk.size() || advance(cursor)) {
+            heap_.push_back(&cursor);
+            std::push_heap(heap_.begin(), heap_.end(), later);
+        }
+    }
+}
+
+bool HistoricalStream::later(const Cursor* a, const Cursor* b) {
+    return a->time() > b->time() || (a->time() == b->time() && a->order > b->order);
+}
+
+bool HistoricalStream::advance(Cursor& cursor) const {
+    while (cursor.next_entry < cursor.entries.size()) {
+        cursor.chunk = store_.load(cursor.entries[cursor.next_entry++], cursor.buffer, start_, end_);
+        cursor.row = 0;
+        if (cursor.chunk.size() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace trading
@@ -2,19 +2,43 @@
 #include "strategy.hpp"
 #include "risk_manager.hpp"
 #include "order_executor.hpp"
+#include "event_loop.hpp"
+#include "feed_handler.hpp"
+#include "price_table.hpp"
+#include "var_engine.hpp"
+#include "monte_carlo.hpp"
+#include "order_throttle.hpp"
+#include "simulated_exchange.hpp"
 #include "utils/logger.hpp"
 #include "common/config.hpp"
 #include <csignal>
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <memory>
+#include <future>
 
 namespace {
-    std::atomic<bool> running{true};
-    
+    // Minimum time between stat() calls on the kill switch trigger file
+    constexpr auto kKillSwitchFilePollInterval = std::chrono::milliseconds(1);
+
+    std::atomic<EventLoop*> event_loop{nullptr};
+    std::atomic<KillSwitch*> kill_switch{nullptr};
+
+    // EventLoop::stop() wakes the loop, so shutdown does not wait for the
+    // next housekeeping pass
     void signalHandler(int signal) {
         spdlog::info("Received signal {}, shutting down...", signal);
-        running = false;
+        if (EventLoop* target = event_loop.load()) {
+            target->stop();
+        }
+    }
+
+    // Only touches atomics; the submit path sees it on the next order
+    void killSwitchHandler(int) {
+        if (KillSwitch* target = kill_switch.load()) {
+            target->engage("SIGUSR1");
+        }
     }
 }
 
@@ -29,13 +53,13 @@ public:
             // Start order executor
             order_executor_->start();
             
+            // Market data pushes events into the loop, which wakes immediately
+            subscribeMarketData();
+            
             // Main event loop
-            while (running) {
-                processMarketData();
-                processSignals();
-                updateRiskMetrics();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
+            event_loop_->run(
+                [this](const EngineEvent& event) { onEvent(event); },
+                [this] { onHousekeeping(); });
             
             // Graceful exit
             shutdown();
@@ -59,34 +83,219 @@ private:
         // Initialize components
         data_loader_ = std::make_unique<DataLoader>();
         strategy_ = std::make_unique<MovingAverageStrategy>();
-        risk_manager_ = std::make_unique<RiskManager>(config_->getRiskLimits());
-        order_executor_ = std::make_unique<OrderExecutor>();
+        risk_manager_ = std::make_unique<RiskManager>(config_->getRiskLimits(), &price_table_);
+        order_executor_ = std::make_unique<OrderExecutor>(order_pool_);
+        order_throttle_ = std::make_unique<OrderThrottle>(config_->getThrottleLimits(), &price_table_);
+        order_throttle_->killSwitch().setTriggerFile(config_->getKillSwitchFile());
+        order_executor_->setThrottle(order_throttle_.get());
+        if (config_->getExecutionVenue() == "simulated") {
+            order_executor_->setVenue(std::make_unique<SimulatedExchange>(
+                config_->getSimulatedExchangeOptions(), &price_table_));
+        } else {
+            order_executor_->setVenue(std::make_unique<ImmediateFillVenue>(&price_table_));
+        }
+        // Fills are applied on the event loop thread, which owns the portfolio
+        order_executor_->setUpdateHandler([this](Span<const OrderUpdate> updates) {
+            for (const OrderUpdate& update : updates) {
+                event_loop_->post(update);
+            }
+        });
+        kill_switch = &order_throttle_->killSwitch();
+        
+        // Configured symbols get the lowest, densest IDs
+        for (const auto& symbol : config_->getSymbols()) {
+            internSymbol(symbol);
+        }
+        event_loop_ = std::make_unique<EventLoop>(config_->getEventLoopOptions());
+        event_loop = event_loop_.get();
+        var_engine_ = std::make_unique<VarEngine>(config_->getVarOptions());
+        monte_carlo_ = std::make_unique<MonteCarloEngine>(config_->getMonteCarloOptions());
+        portfolio_.setSessionRoll(config_->getSessionRollOffset());
         
         // Setup signal handling
         signal(SIGINT, signalHandler);
         signal(SIGTERM, signalHandler);
+        signal(SIGUSR1, killSwitchHandler);
         
         spdlog::info("Trading engine initialized successfully");
     }
 
-    void processMarketData() {
+    void subscribeMarketData() {
+        FeedConfig feed_config = config_->getFeedConfig();
+        if (feed_config.source != "python") {
+            // Native feed: decoded on its own I/O thread, no interpreter involved
+            feed_handler_ = std::make_unique<FeedHandler>(
+                makeMarketDataSource(feed_config),
+                [this](const MarketData& data) { event_loop_->post(data); },
+                feed_config.pace,
+                feed_config.speed);
+            feed_handler_->start();
+            return;
+        }
+
+        for (const auto& symbol : config_->getSymbols()) {
+            data_loader_->subscribeToRealTimeData(symbol, [this](const MarketData& data) {
+                event_loop_->post(data);
+            });
+        }
+    }
+
+    void onEvent(const EngineEvent& event) {
+        switch (event.type) {
+            case EngineEvent::Type::MARKET_DATA:
+                processMarketData(event.market_data);
+                break;
+            case EngineEvent::Type::ORDER_UPDATE:
+                processOrderUpdate(event.order_update);
+                break;
+            case EngineEvent::Type::WAKEUP:
+                break;
+        }
+    }
+
+    void onHousekeeping() {
+        pollKillSwitch();
+        advanceIdleSessionClock();
+        // O(n^2) in tracked symbols, so kept off the per-tick path
+        if (var_engine_->sampleIfDue(std::chrono::steady_clock::now()) || exposures_changed_) {
+            var_estimate_ = var_engine_->evaluate();
+            exposures_changed_ = false;
+        }
+        updateTailRisk();
+        updateRiskMetrics();
+    }
+
+    // The session clock runs on event time only, so replayed feeds roll
+    // at their own midnights. With no tick since the last pass, the last
+    // tick time is carried forward by the wall time elapsed since, which
+    // rolls the session when the feed goes quiet.
+    void advanceIdleSessionClock() {
+        if (ticks_since_housekeeping_ > 0) {
+            ticks_since_housekeeping_ = 0;
+            return;
+        }
+        if (last_tick_time_ == Timestamp()) {
+            return;
+        }
+        auto idle = std::chrono::steady_clock::now() - last_tick_received_;
+        portfolio_.advanceClock(last_tick_time_ + std::chrono::duration_cast<Timestamp::duration>(idle));
+    }
+
+    // Called on housekeeping and before every batch of signals, so the
+    // trigger file takes effect before the next order goes out. The stat()
+    // runs at most once per kKillSwitchFilePollInterval.
+    void pollKillSwitch() {
+        KillSwitch& kill = order_throttle_->killSwitch();
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_kill_switch_poll_) {
+            kill.pollTriggerFile();
+            next_kill_switch_poll_ = now + kKillSwitchFilePollInterval;
+        }
+        bool engaged = kill.isEngaged();
+        if (engaged != kill_switch_reported_) {
+            if (engaged) {
+                spdlog::critical("Kill switch engaged ({}), all new orders are blocked", kill.getReason());
+            } else {
+                spdlog::warn("Kill switch reset, order flow resumed");
+            }
+            kill_switch_reported_ = engaged;
+        }
+    }
+
+    // Runs the Monte Carlo simulation off the event loop and hands the
+    // result to the risk manager once it completes
+    void updateTailRisk() {
+        auto now = std::chrono::steady_clock::now();
+        if (simulation_.valid()) {
+            if (simulation_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return;
+            }
+            try {
+                MonteCarloResult result = simulation_.get();
+                risk_manager_->updateTailRisk(result.var, result.expected_shortfall);
+            } catch (const std::exception& e) {
+                spdlog::error("Monte Carlo run failed: {}", e.what());
+            }
+        }
+        if (now < next_simulation_) {
+            return;
+        }
+        next_simulation_ = now + monte_carlo_->getOptions().run_interval;
+        var_engine_->buildModel(simulation_model_);
+        simulation_ = std::async(std::launch::async, [this] {
+            return monte_carlo_->run(simulation_model_);
+        });
+    }
+
+    void processMarketData(const MarketData& market_data) {
         try {
-            for (const auto& symbol : config_->getSymbols()) {
-                auto market_data = data_loader_->loadMarketData(symbol);
-                strategy_->onMarketData(market_data);
+            price_table_.update(market_data);
+            portfolio_.advanceClock(market_data.timestamp);
+            if (market_data.timestamp > last_tick_time_) {
+                last_tick_time_ = market_data.timestamp;
+                last_tick_received_ = std::chrono::steady_clock::now();
+            }
+            ++ticks_since_housekeeping_;
+            portfolio_.markPrice(market_data.symbol_id, market_data.last_price);
+            var_engine_->onPrice(market_data.symbol_id, market_data.last_price);
+            if (const Position* position = portfolio_.getPosition(market_data.symbol_id)) {
+                var_engine_->setExposure(market_data.symbol_id, position->getMarketValue());
+                exposures_changed_ = true;
             }
+            processSignals(strategy_->onMarketData(market_data));
         } catch (const std::exception& e) {
             spdlog::error("Error processing market data: {}", e.what());
         }
     }
 
-    void processSignals() {
+    void processOrderUpdate(const OrderUpdate& update) {
+        const Order& order = update.order;
+        if (update.fill_quantity > 0.0) {
+            double quantity = order.getSide() == OrderSide::BUY ? update.fill_quantity : -update.fill_quantity;
+            portfolio_.applyFill(order.getSymbol(), quantity, update.fill_price);
+            if (const Position* position = portfolio_.getPosition(order.getSymbol())) {
+                var_engine_->setExposure(order.getSymbol(), position->getMarketValue());
+                exposures_changed_ = true;
+            }
+        }
+        strategy_->onOrderUpdate(order);
+    }
+
+    void processSignals(const std::vector<Strategy::Signal>& signals) {
+        if (signals.empty()) {
+            return;
+        }
+        // A trigger file created since the last check blocks this batch
+        pollKillSwitch();
+        if (order_throttle_->killSwitch().isEngaged()) {
+            return;
+        }
         try {
-            auto signals = strategy_->getSignals();
+            pending_orders_.clear();
             for (const auto& signal : signals) {
-                auto order = createOrder(signal);
-                if (risk_manager_->checkOrderRisk(*order, portfolio_)) {
-                    order_executor_->submitOrder(order);
+                Order* order = createOrder(signal);
+                if (!order) {
+                    spdlog::error("Order pool exhausted, dropping signal for {}",
+                                  symbolName(signal.symbol));
+                    continue;
+                }
+                pending_orders_.push_back(order);
+            }
+
+            // One pass over the whole set so later orders see earlier ones' exposure
+            pending_verdicts_.resize(pending_orders_.size());
+            risk_manager_->checkOrderBatch({pending_orders_.data(), pending_orders_.size()}, portfolio_,
+                                           pending_verdicts_);
+            for (size_t i = 0; i < pending_orders_.size(); ++i) {
+                Order* order = pending_orders_[i];
+                if (!pending_verdicts_[i]) {
+                    spdlog::warn("Order {} for {} rejected: {} limit",
+                                 formatOrderId(order->getOrderId()),
+                                 symbolName(order->getSymbol()),
+                                 toString(pending_verdicts_[i].reason));
+                    order_pool_.release(order);
+                } else if (!order_executor_->submitOrder(order)) {
+                    order_pool_.release(order);
                 }
             }
         } catch (const std::exception& e) {
@@ -96,13 +305,14 @@ private:
 
     void updateRiskMetrics() {
         try {
-            risk_manager_->updateRiskMetrics(portfolio_);
-            auto metrics = risk_manager_->getRiskMetrics();
+            risk_manager_->updateRiskMetrics(portfolio_, var_estimate_);
+            RiskMetrics metrics = risk_manager_->getRiskMetrics();
             
             // Log risk metrics
-            spdlog::debug("Risk metrics - Drawdown: {:.2f}%, Leverage: {:.2f}x",
-                metrics["drawdown"] * 100,
-                metrics["leverage"]);
+            spdlog::debug("Risk metrics - Drawdown: {:.2f}%, Leverage: {:.2f}x, VaR: ${:.2f}",
+                metrics.drawdown * 100,
+                metrics.leverage,
+                metrics.var);
                 
         } catch (const std::exception& e) {
             spdlog::error("Error updating risk metrics: {}", e.what());
@@ -111,13 +321,21 @@ private:
 
     void shutdown() {
         spdlog::info("Shutting down trading engine...");
+        event_loop = nullptr;
+        kill_switch = nullptr;
+        if (feed_handler_) {
+            feed_handler_->stop();
+        }
         order_executor_->stop();
+        if (simulation_.valid()) {
+            simulation_.wait();
+        }
         // Save state and clean up resources
         spdlog::info("Trading engine shutdown complete");
     }
 
-    std::shared_ptr<Order> createOrder(const Strategy::Signal& signal) {
-        return std::make_shared<Order>(
+    Order* createOrder(const Strategy::Signal& signal) {
+        return order_pool_.acquire(
             signal.symbol,
             signal.side,
             OrderType::MARKET,
@@ -126,27 +344,38 @@ private:
     }
 
     double calculateOrderSize(const Strategy::Signal& signal) {
-        // Calculate order size based on signal strength and money management rules
-        double portfolio_value = portfolio_.getTotalValue(getCurrentPrices());
-        return portfolio_value * config_->getPositionSizeLimit() * signal.strength;
-    }
-
-    std::map<std::string, double> getCurrentPrices() {
-        std::map<std::string, double> prices;
-        for (const auto& symbol : config_->getSymbols()) {
-            auto market_data = data_loader_->loadMarketData(symbol);
-            prices[symbol] = market_data.last_price;
-        }
-        return prices;
+        // Shared with BacktestEngine so backtests size orders the same way
+        return signalOrderQuantity(signal, price_table_.getLastPrice(signal.symbol),
+                                   portfolio_.getTotalValue(), config_->getPositionSizeLimit());
     }
 
 private:
+    OrderPool order_pool_;
     std::unique_ptr<Config> config_;
     std::unique_ptr<DataLoader> data_loader_;
     std::unique_ptr<Strategy> strategy_;
     std::unique_ptr<RiskManager> risk_manager_;
     std::unique_ptr<OrderExecutor> order_executor_;
+    std::unique_ptr<OrderThrottle> order_throttle_;
+    bool kill_switch_reported_ = false;
+    std::chrono::steady_clock::time_point next_kill_switch_poll_{};
+    std::unique_ptr<EventLoop> event_loop_;
+    std::unique_ptr<FeedHandler> feed_handler_;
+    std::unique_ptr<VarEngine> var_engine_;
+    VarEstimate var_estimate_;  // Latest estimate, refreshed by housekeeping
+    bool exposures_changed_ = false;  // Since var_estimate_ was computed
+    std::unique_ptr<MonteCarloEngine> monte_carlo_;
+    MarketModel simulation_model_;  // Owned by the running simulation until it completes
+    std::future<MonteCarloResult> simulation_;
+    std::chrono::steady_clock::time_point next_simulation_{};
     Portfolio portfolio_;
+    // Session clock state, see advanceIdleSessionClock
+    Timestamp last_tick_time_{};
+    std::chrono::steady_clock::time_point last_tick_received_{};
+    uint64_t ticks_since_housekeeping_ = 0;
+    PriceTable price_table_;  // Written by the event loop, read by sizing and risk
+    std::vector<Order*> pending_orders_;  // Scratch for one batch of signals
+    std::vector<RiskVerdict> pending_verdicts_;  // Their risk verdicts
 };
 
 int main() {
@@ -0,0 +1,396 @@
+#include "matching_engine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace trading {
+
+namespace {
+    // Quantities at or below this are treated as zero
+    constexpr double kQuantityEpsilon = 1e-9;
+
+    bool isStop(OrderType type) {
+        return type == OrderType::STOP || type == OrderType::STOP_LIMIT;
+    }
+
+    bool hasLimit(OrderType type) {
+        return type == OrderType::LIMIT || type == OrderType::STOP_LIMIT;
+    }
+
+    // Bids are kept ascending and asks descending, best price last
+    template <typename Levels>
+    auto findLevel(Levels& levels, bool descending, int64_t price) {
+        return std::lower_bound(levels.begin(), levels.end(), price,
+                                [descending](const auto& level, int64_t value) {
+                                    return descending ? level.price > value : level.price < value;
+                                });
+    }
+}
+
+MatchingEngine::MatchingEngine() : MatchingEngine(Options()) {}
+
+MatchingEngine::MatchingEngine(const Options& options) : options_(options) {
+    nodes_.reserve(4096);
+    index_.reserve(4096);
+}
+
+void MatchingEngine::submit(const Order& order, Timestamp now) {
+    OrderId order_id = order.getOrderId();
+    OrderType type = order.getType();
+    int64_t limit = hasLimit(type) ? toTicks(order.getPrice()) : 0;
+    int64_t stop = isStop(type) ? toTicks(order.getStopPrice()) : 0;
+    bool valid = order.getSymbol() < SymbolTable::kMaxSymbols &&
+                 order.getRemainingQuantity() > kQuantityEpsilon &&
+                 (!hasLimit(type) || limit > 0) && (!isStop(type) || stop > 0) &&
+                 index_.find(order_id) == index_.end();
+    if (!valid) {
+        emit(ExecutionReport::Type::REJECTED, order_id, 0.0, 0.0, now);
+        return;
+    }
+
+    Book& book = bookFor(order.getSymbol());
+    uint32_t index = allocate();
+    Node& node = nodes_[index];
+    node.id = order_id;
+    node.symbol = order.getSymbol();
+    node.side = order.getSide();
+    node.type = type;
+    node.stop = stop;
+    node.quantity = order.getQuantity();
+    node.filled = order.getFilledQuantity();
+    if (hasLimit(type)) {
+        node.limit = limit;
+    } else {
+        node.limit = node.side == OrderSide::BUY ? std::numeric_limits<int64_t>::max()
+                                                 : std::numeric_limits<int64_t>::min();
+    }
+    index_.emplace(order_id, index);
+    ++book.open;
+
+    if (isStop(type)) {
+        bool buy = node.side == OrderSide::BUY;
+        bool triggered = book.last > 0 && (buy ? book.last >= stop : book.last <= stop);
+        if (!triggered) {
+            node.waiting = true;
+            if (buy) {
+                book.buy_stops.emplace(stop, index);
+            } else {
+                book.sell_stops.emplace(stop, index);
+            }
+            return;
+        }
+    }
+    execute(book, index, now);
+    triggerStops(book, now);
+}
+
+bool MatchingEngine::cancel(OrderId order_id, Timestamp now) {
+    auto it = index_.find(order_id);
+    if (it == index_.end()) {
+        return false;
+    }
+    uint32_t index = it->second;
+    Book& book = books_[nodes_[index].symbol];
+    if (nodes_[index].waiting) {
+        removeStop(book, index);
+    } else {
+        unlink(book, index);
+    }
+    release(book, index);
+    emit(ExecutionReport::Type::CANCELLED, order_id, 0.0, 0.0, now);
+    return true;
+}
+
+bool MatchingEngine::replace(OrderId order_id, double quantity, double price, Timestamp now) {
+    auto it = index_.find(order_id);
+    if (it == index_.end()) {
+        return false;
+    }
+    uint32_t index = it->second;
+    Node& node = nodes_[index];
+    Book& book = books_[node.symbol];
+    int64_t limit = hasLimit(node.type) ? toTicks(price) : node.limit;
+    if (quantity < node.filled - kQuantityEpsilon || (hasLimit(node.type) && limit <= 0)) {
+        return false;
+    }
+    emit(ExecutionReport::Type::REPLACED, order_id, quantity, price, now);
+
+    // Untriggered stops are queued by stop price, which does not change
+    if (node.waiting || (limit == node.limit && quantity <= node.quantity)) {
+        node.quantity = quantity;
+        node.limit = limit;
+        if (node.remaining() <= kQuantityEpsilon) {
+            if (node.waiting) {
+                removeStop(book, index);
+            } else {
+                unlink(book, index);
+            }
+            release(book, index);
+        }
+        return true;
+    }
+
+    unlink(book, index);
+    node.quantity = quantity;
+    node.limit = limit;
+    if (node.remaining() <= kQuantityEpsilon) {
+        release(book, index);
+        return true;
+    }
+    execute(book, index, now);
+    triggerStops(book, now);
+    return true;
+}
+
+void MatchingEngine::onTrade(SymbolId symbol, double price, double quantity, Timestamp now) {
+    int64_t ticks = toTicks(price);
+    if (symbol >= SymbolTable::kMaxSymbols || ticks <= 0) {
+        return;
+    }
+    Book& book = bookFor(symbol);
+    book.last = ticks;
+    if (book.open == 0) {
+        return;
+    }
+    fillResting(book, OrderSide::BUY, ticks, quantity, now);
+    fillResting(book, OrderSide::SELL, ticks, quantity, now);
+    triggerStops(book, now);
+}
+
+double MatchingEngine::getBestBid(SymbolId symbol) const {
+    const Book* book = findBook(symbol);
+    return (book && !book->bids.empty()) ? toPrice(book->bids.back().price) : 0.0;
+}
+
+double MatchingEngine::getBestAsk(SymbolId symbol) const {
+    const Book* book = findBook(symbol);
+    return (book && !book->asks.empty()) ? toPrice(book->asks.back().price) : 0.0;
+}
+
+double MatchingEngine::getLastPrice(SymbolId symbol) const {
+    const Book* book = findBook(symbol);
+    return book ? toPrice(book->last) : 0.0;
+}
+
+bool MatchingEngine::hasOpenOrders(SymbolId symbol) const {
+    const Book* book = findBook(symbol);
+    return book && book->open > 0;
+}
+
+MatchingEngine::Book& MatchingEngine::bookFor(SymbolId symbol) {
+    if (symbol >= books_.size()) {
+        books_.resize(symbol + 1);
+    }
+    return books_[symbol];
+}
+
+const MatchingEngine::Book* MatchingEngine::findBook(SymbolId symbol) const {
+    return symbol < books_.size() ? &books_[symbol] : nullptr;
+}
+
+int64_t MatchingEngine::toTicks(double price) const {
+    return std::llround(price / options_.tick_size);
+}
+
+uint32_t MatchingEngine::allocate() {
+    if (free_.empty()) {
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+    uint32_t index = free_.back();
+    free_.pop_back();
+    nodes_[index] = Node();
+    return index;
+}
+
+void MatchingEngine::release(Book& book, uint32_t index) {
+    index_.erase(nodes_[index].id);
+    --book.open;
+    free_.push_back(index);
+}
+
+void MatchingEngine::execute(Book& book, uint32_t index, Timestamp now) {
+    Node& node = nodes_[index];
+    bool buy = node.side == OrderSide::BUY;
+    std::vector<Level>& levels = buy ? book.asks : book.bids;
+    auto crosses = [&](int64_t price) { return buy ? node.limit >= price : node.limit <= price; };
+
+    while (node.remaining() > kQuantityEpsilon) {
+        bool has_level = !levels.empty();
+        int64_t level_price = has_level ? levels.back().price : 0;
+
+        // Outside liquidity at the last price, when it beats the book
+        if (options_.outside_liquidity && book.last > 0 && crosses(book.last) &&
+            (!has_level || (buy ? book.last < level_price : book.last > level_price))) {
+            fill(index, node.remaining(), book.last, now);
+            break;
+        }
+        if (!has_level || !crosses(level_price)) {
+            break;
+        }
+
+        uint32_t resting = levels.back().head;
+        double quantity = std::min(node.remaining(), nodes_[resting].remaining());
+        fill(resting, quantity, level_price, now);
+        fill(index, quantity, level_price, now);
+        book.last = level_price;
+        if (nodes_[resting].remaining() <= kQuantityEpsilon) {
+            unlink(book, resting);
+            release(book, resting);
+        }
+    }
+
+    if (node.remaining() > kQuantityEpsilon && hasLimit(node.type)) {
+        rest(book, index);
+        return;
+    }
+    if (node.remaining() > kQuantityEpsilon) {
+        // Market orders never rest
+        emit(ExecutionReport::Type::CANCELLED, node.id, 0.0, 0.0, now);
+    }
+    release(book, index);
+}
+
+void MatchingEngine::rest(Book& book, uint32_t index) {
+    Node& node = nodes_[index];
+    switch (options_.queue_position) {
+        case QueuePosition::FRONT: node.ahead = 0.0; break;
+        case QueuePosition::BEHIND: node.ahead = options_.queue_ahead; break;
+        case QueuePosition::THROUGH_ONLY: node.ahead = std::numeric_limits<double>::infinity(); break;
+    }
+
+    bool buy = node.side == OrderSide::BUY;
+    std::vector<Level>& levels = buy ? book.bids : book.asks;
+    auto it = findLevel(levels, !buy, node.limit);
+    if (it != levels.end() && it->price == node.limit) {
+        node.prev = it->tail;
+        node.next = kNil;
+        nodes_[it->tail].next = index;
+        it->tail = index;
+    } else {
+        node.prev = kNil;
+        node.next = kNil;
+        levels.insert(it, Level{node.limit, index, index});
+    }
+}
+
+void MatchingEngine::unlink(Book& book, uint32_t index) {
+    Node& node = nodes_[index];
+    bool buy = node.side == OrderSide::BUY;
+    std::vector<Level>& levels = buy ? book.bids : book.asks;
+    auto it = findLevel(levels, !buy, node.limit);
+    if (it == levels.end() || it->price != node.limit) {
+        return;
+    }
+    if (node.prev != kNil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        it->head = node.next;
+    }
+    if (node.next != kNil) {
+        nodes_[node.next].prev = node.prev;
+    } else {
+        it->tail = node.prev;
+    }
+    node.prev = node.next = kNil;
+    if (it->head == kNil) {
+        levels.erase(it);
+    }
+}
+
+void MatchingEngine::removeStop(Book& book, uint32_t index) {
+    const Node& node = nodes_[index];
+    auto erase = [&](auto& stops) {
+        auto range = stops.equal_range(node.stop);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == index) {
+                stops.erase(it);
+                return;
+            }
+        }
+    };
+    if (node.side == OrderSide::BUY) {
+        erase(book.buy_stops);
+    } else {
+        erase(book.sell_stops);
+    }
+}
+
+void MatchingEngine::fill(uint32_t index, double quantity, int64_t price, Timestamp now) {
+    Node& node = nodes_[index];
+    node.filled += quantity;
+    emit(ExecutionReport::Type::FILL, node.id, quantity, toPrice(price), now);
+}
+
+void MatchingEngine::fillResting(Book& book, OrderSide side, int64_t price, double quantity, Timestamp now) {
+    bool buy = side == OrderSide::BUY;
+    std::vector<Level>& levels = buy ? book.bids : book.asks;
+
+    // Levels the trade went through were certainly reached
+    while (!levels.empty() && (buy ? levels.back().price > price : levels.back().price < price)) {
+        Level level = levels.back();
+        levels.pop_back();
+        for (uint32_t index = level.head; index != kNil;) {
+            uint32_t next = nodes_[index].next;
+            fill(index, nodes_[index].remaining(), level.price, now);
+            release(book, index);
+            index = next;
+        }
+    }
+    if (levels.empty() || levels.back().price != price) {
+        return;
+    }
+
+    // At the trade price the volume first clears outside quantity queued
+    // ahead of each order, then our own orders in time priority
+    double allocated = 0.0;
+    for (uint32_t index = levels.back().head; index != kNil;) {
+        Node& node = nodes_[index];
+        uint32_t next = node.next;
+        double reach = quantity - node.ahead - allocated;
+        node.ahead = std::max(0.0, node.ahead - quantity);
+        if (reach > kQuantityEpsilon) {
+            double filled = std::min(reach, node.remaining());
+            fill(index, filled, price, now);
+            allocated += filled;
+            if (node.remaining() <= kQuantityEpsilon) {
+                unlink(book, index);
+                release(book, index);
+            }
+        }
+        index = next;
+    }
+}
+
+void MatchingEngine::triggerStops(Book& book, Timestamp now) {
+    // One at a time: each triggered order can move the last price again
+    while (book.last > 0) {
+        uint32_t index;
+        if (!book.buy_stops.empty() && book.buy_stops.begin()->first <= book.last) {
+            index = book.buy_stops.begin()->second;
+            book.buy_stops.erase(book.buy_stops.begin());
+        } else if (!book.sell_stops.empty() && book.sell_stops.begin()->first >= book.last) {
+            index = book.sell_stops.begin()->second;
+            book.sell_stops.erase(book.sell_stops.begin());
+        } else {
+            return;
+        }
+        nodes_[index].waiting = false;
+        execute(book, index, now);
+    }
+}
+
+void MatchingEngine::emit(ExecutionReport::Type type, OrderId order_id, double quantity,
+                          double price, Timestamp now) {
+    if (sink_) {
+        ExecutionReport report;
+        report.type = type;
+        report.order_id = order_id;
+        report.quantity = quantity;
+        report.price = price;
+        report.timestamp = now;
+        sink_(report);
+    }
+}
+
+} // namespace trading
@@ -0,0 +1,125 @@
+#include "monte_carlo.hpp"
+#include "common/philox.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace trading {
+
+MonteCarloEngine::MonteCarloEngine() : MonteCarloEngine(Options()) {}
+
+MonteCarloEngine::MonteCarloEngine(const Options& options) : options_(options) {
+    if (options.scenarios == 0 || options.block_size == 0) {
+        throw std::invalid_argument("Monte Carlo needs a positive scenario and block count");
+    }
+    if (options.confidence <= 0.5 || options.confidence >= 1.0) {
+        throw std::invalid_argument("Monte Carlo confidence must be in (0.5, 1)");
+    }
+    if (options.horizon == 0) {
+        throw std::invalid_argument("Monte Carlo horizon must be positive");
+    }
+    if (options.ewma_decay <= 0.0 || options.ewma_decay >= 1.0) {
+        throw std::invalid_argument("Monte Carlo EWMA decay must be in (0, 1)");
+    }
+}
+
+MonteCarloResult MonteCarloEngine::run(const MarketModel& model) {
+    MonteCarloResult result;
+    if (model.assets == 0 || model.samples < 2) {
+        return result;
+    }
+    filterRows(model);
+
+    pnl_.resize(options_.scenarios);
+    const size_t blocks = (options_.scenarios + options_.block_size - 1) / options_.block_size;
+    size_t thread_count = options_.threads ? options_.threads : std::thread::hardware_concurrency();
+    thread_count = std::max<size_t>(1, std::min(thread_count, blocks));
+
+    std::atomic<size_t> next_block{0};
+    auto worker = [&] {
+        for (size_t block = next_block.fetch_add(1, std::memory_order_relaxed); block < blocks;
+             block = next_block.fetch_add(1, std::memory_order_relaxed)) {
+            simulateBlock(block, model.samples, row_pnl_.data());
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < thread_count; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Tail statistics over the full, index-ordered P&L vector
+    const size_t m = options_.scenarios;
+    size_t tail = static_cast<size_t>(std::ceil((1.0 - options_.confidence) * m - 1e-9));
+    size_t k = tail > 0 ? tail - 1 : 0;
+    std::nth_element(pnl_.begin(), pnl_.begin() + k, pnl_.end());
+    double tail_sum = 0.0;
+    for (size_t s = 0; s <= k; ++s) {
+        tail_sum += pnl_[s];
+    }
+    result.var = -pnl_[k];
+    result.expected_shortfall = -tail_sum / (k + 1);
+    result.scenarios = m;
+    return result;
+}
+
+void MonteCarloEngine::filterRows(const MarketModel& model) {
+    // The book is linear, so each filtered row reduces to one P&L and a
+    // scenario never touches the per-asset vectors again
+    const size_t n = model.assets;
+    const size_t m = model.samples;
+    const double decay = options_.ewma_decay;
+    row_pnl_.assign(m, 0.0);
+    variance_.resize(m);
+    for (size_t i = 0; i < n; ++i) {
+        double w = model.exposures[i];
+        if (w == 0.0) {
+            continue;
+        }
+        // Seeded with the window's mean square so early rows are not
+        // rescaled from an arbitrary starting level
+        double variance = 0.0;
+        for (size_t t = 0; t < m; ++t) {
+            double r = model.returns[t * n + i];
+            variance += r * r;
+        }
+        variance /= m;
+        for (size_t t = 0; t < m; ++t) {
+            double r = model.returns[t * n + i];
+            variance_[t] = variance;  // Forecast made before row t
+            variance = decay * variance + (1.0 - decay) * r * r;
+        }
+        // variance now forecasts the next interval
+        for (size_t t = 0; t < m; ++t) {
+            double scale = variance_[t] > 0.0 ? std::sqrt(variance / variance_[t]) : 1.0;
+            row_pnl_[t] += w * model.returns[t * n + i] * scale;
+        }
+    }
+}
+
+void MonteCarloEngine::simulateBlock(size_t block, size_t samples, const double* row_pnl) {
+    Philox4x32 rng(options_.seed);
+    size_t begin = block * options_.block_size;
+    size_t end = std::min(begin + options_.block_size, options_.scenarios);
+    for (size_t scenario = begin; scenario < end; ++scenario) {
+        double pnl = 0.0;
+        for (size_t h = 0; h < options_.horizon; h += 4) {
+            auto bits = rng({static_cast<uint32_t>(scenario), static_cast<uint32_t>(scenario >> 32),
+                             static_cast<uint32_t>(h / 4), 0});
+            size_t count = std::min<size_t>(4, options_.horizon - h);
+            for (size_t k = 0; k < count; ++k) {
+                // Multiply-shift maps 32 random bits onto [0, samples)
+                pnl += row_pnl[(static_cast<uint64_t>(bits[k]) * samples) >> 32];
+            }
+        }
+        pnl_[scenario] = pnl;
+    }
+}
+
+} // namespace trading
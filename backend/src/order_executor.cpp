@@ -1,69 +1,262 @@
 #include "order_executor.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 namespace trading {
 
-OrderExecutor::OrderExecutor() : running_(false) {
+namespace {
+    // Bounds how long the consumer sleeps before rechecking running_
+    constexpr auto kIdleWakeInterval = std::chrono::milliseconds(100);
+    // Commands handled before venue reports are polled and updates flushed
+    constexpr size_t kMaxCommandsPerBatch = 256;
+}
+
+OrderExecutor::OrderExecutor(OrderPool& pool) : OrderExecutor(pool, Options()) {}
+
+OrderExecutor::OrderExecutor(OrderPool& pool, const Options& options)
+    : pool_(pool)
+    , options_(options)
+    , waiter_(options.wait_strategy)
+    , venue_(std::make_unique<ImmediateFillVenue>())
+    , table_(2 * (pool.capacity() + options.status_retention))
+    , running_(false) {
+    if (options_.multi_producer) {
+        mpsc_queue_ = std::make_unique<MpscQueue<OrderCommand>>(options_.queue_capacity);
+    } else {
+        spsc_queue_ = std::make_unique<SpscQueue<OrderCommand>>(options_.queue_capacity);
+    }
+    updates_.reserve(kMaxCommandsPerBatch);
+    venue_->setReportSink([this](const ExecutionReport& report) { handleReport(report); });
 }
 
 OrderExecutor::~OrderExecutor() {
     stop();
 }
 
+void OrderExecutor::setVenue(std::unique_ptr<ExecutionVenue> venue) {
+    venue_ = std::move(venue);
+    venue_->setReportSink([this](const ExecutionReport& report) { handleReport(report); });
+}
+
 void OrderExecutor::start() {
     running_ = true;
     execution_thread_ = std::thread(&OrderExecutor::executionLoop, this);
-    spdlog::info("Order executor started");
+    spdlog::info("Order executor started ({} venue)", venue_->describe());
 }
 
 void OrderExecutor::stop() {
     running_ = false;
-    cv_.notify_one();
-    
+    waiter_.notify();
+
+    // Synchronous use (drain() only) never starts the thread
     if (execution_thread_.joinable()) {
         execution_thread_.join();
+        spdlog::info("Order executor stopped");
     }
-    spdlog::info("Order executor stopped");
 }
 
-void OrderExecutor::submitOrder(std::shared_ptr<Order> order) {
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        order_queue_.push(order);
+bool OrderExecutor::submitOrder(Order* order) {
+    OrderId order_id = order->getOrderId();
+    if (throttle_) {
+        RiskRejectReason reason = throttle_->check(*order);
+        if (reason != RiskRejectReason::NONE) {
+            order->setStatus(OrderStatus::REJECTED);
+            spdlog::warn("Order {} rejected: {}", formatOrderId(order_id), toString(reason));
+            return false;
+        }
+    }
+    OrderCommand command;
+    command.type = OrderCommand::Type::NEW;
+    command.order = order;
+    command.order_id = order_id;
+    if (!tryEnqueue(command)) {
+        spdlog::error("Order queue full, rejecting order {}", formatOrderId(order_id));
+        return false;
+    }
+    waiter_.notify();
+    spdlog::debug("Order submitted: {}", formatOrderId(order_id));
+    return true;
+}
+
+bool OrderExecutor::cancelOrder(OrderId order_id) {
+    OrderCommand command;
+    command.type = OrderCommand::Type::CANCEL;
+    command.order_id = order_id;
+    if (!tryEnqueue(command)) {
+        spdlog::error("Order queue full, dropping cancel for {}", formatOrderId(order_id));
+        return false;
     }
-    cv_.notify_one();
-    spdlog::info("Order submitted: {}", order->getOrderId());
+    waiter_.notify();
+    return true;
+}
+
+bool OrderExecutor::replaceOrder(OrderId order_id, double quantity, double price) {
+    OrderCommand command;
+    command.type = OrderCommand::Type::REPLACE;
+    command.order_id = order_id;
+    command.quantity = quantity;
+    command.price = price;
+    if (!tryEnqueue(command)) {
+        spdlog::error("Order queue full, dropping replace for {}", formatOrderId(order_id));
+        return false;
+    }
+    waiter_.notify();
+    return true;
+}
+
+std::optional<OrderStatus> OrderExecutor::getOrderStatus(OrderId order_id) const {
+    OrderStatus status;
+    if (table_.getStatus(order_id, status)) {
+        return status;
+    }
+    return std::nullopt;
 }
 
 void OrderExecutor::executionLoop() {
     while (running_) {
-        std::shared_ptr<Order> order;
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
-            cv_.wait(lock, [this] { 
-                return !order_queue_.empty() || !running_; 
-            });
-            
-            if (!running_) break;
-            
-            order = order_queue_.front();
-            order_queue_.pop();
+        if (processPending() || !venue_->idle()) {
+            continue;
+        }
+        waiter_.waitUntil([this] {
+            return !queueEmpty() || !running_;
+        }, std::chrono::steady_clock::now() + kIdleWakeInterval);
+    }
+}
+
+void OrderExecutor::drain() {
+    while (processPending()) {
+    }
+}
+
+bool OrderExecutor::processPending() {
+    OrderCommand command;
+    size_t handled = 0;
+    while (handled < kMaxCommandsPerBatch && tryDequeue(command)) {
+        handleCommand(command);
+        ++handled;
+    }
+    venue_->poll();
+    bool had_updates = !updates_.empty();
+    flushUpdates();
+    return handled > 0 || had_updates;
+}
+
+void OrderExecutor::handleCommand(const OrderCommand& command) {
+    switch (command.type) {
+        case OrderCommand::Type::NEW: {
+            Order* order = command.order;
+            if (!table_.insert(order->getOrderId(), order, OrderStatus::PENDING)) {
+                spdlog::error("Order table full, rejecting order {}", formatOrderId(order->getOrderId()));
+                order->setStatus(OrderStatus::REJECTED);
+                updates_.push_back(OrderUpdate{*order});
+                pool_.release(order);
+                return;
+            }
+            order->setStatus(OrderStatus::PENDING);
+            venue_->submit(*order);
+            break;
+        }
+        case OrderCommand::Type::CANCEL: {
+            Order* order = table_.find(command.order_id);
+            if (!order || !order->isActive()) {
+                spdlog::debug("Cancel for inactive order {} ignored", formatOrderId(command.order_id));
+                return;
+            }
+            venue_->cancel(command.order_id);
+            break;
+        }
+        case OrderCommand::Type::REPLACE: {
+            Order* order = table_.find(command.order_id);
+            if (!order || !order->isActive() || command.quantity < order->getFilledQuantity()) {
+                spdlog::warn("Replace for order {} refused", formatOrderId(command.order_id));
+                return;
+            }
+            venue_->replace(command.order_id, command.quantity, command.price);
+            break;
         }
-        
-        executeOrder(order);
     }
 }
 
-void OrderExecutor::executeOrder(std::shared_ptr<Order> order) {
-    try {
-        // Implement actual order execution logic
-        order->setStatus(OrderStatus::FILLED);
-        spdlog::info("Order executed: {}", order->getOrderId());
-        
-    } catch (const std::exception& e) {
-        order->setStatus(OrderStatus::REJECTED);
-        spdlog::error("Order execution failed: {}", e.what());
+void OrderExecutor::handleReport(const ExecutionReport& report) {
+    Order* order = table_.find(report.order_id);
+    if (!order || !order->isActive()) {
+        spdlog::warn("Report for unknown or final order {}", formatOrderId(report.order_id));
+        return;
     }
+
+    OrderUpdate update;
+    switch (report.type) {
+        case ExecutionReport::Type::FILL: {
+            // Never fill beyond the order, whatever the venue says
+            double quantity = std::min(report.quantity, order->getRemainingQuantity());
+            if (quantity <= 0.0) {
+                spdlog::warn("Empty fill for order {} ignored", formatOrderId(report.order_id));
+                return;
+            }
+            order->applyFill(quantity, report.price);
+            update.fill_quantity = quantity;
+            update.fill_price = report.price;
+            break;
+        }
+        case ExecutionReport::Type::CANCELLED:
+            order->setStatus(OrderStatus::CANCELLED);
+            break;
+        case ExecutionReport::Type::REJECTED:
+            order->setStatus(OrderStatus::REJECTED);
+            break;
+        case ExecutionReport::Type::REPLACED:
+            order->setQuantity(report.quantity);
+            order->setPrice(report.price);
+            if (order->getFilledQuantity() >= report.quantity) {
+                order->setStatus(OrderStatus::FILLED);
+            }
+            break;
+    }
+    if (report.timestamp != Timestamp()) {
+        order->setUpdateTime(report.timestamp);
+    }
+    table_.setStatus(order->getOrderId(), order->getStatus());
+
+    update.order = *order;
+    updates_.push_back(update);
+    if (!order->isActive()) {
+        retire(order);
+    }
+}
+
+void OrderExecutor::retire(Order* order) {
+    OrderId order_id = order->getOrderId();
+    table_.detach(order_id);
+    pool_.release(order);
+
+    // Final statuses stay readable for a while, oldest dropped first
+    retired_.push_back(order_id);
+    if (retired_.size() > options_.status_retention) {
+        table_.erase(retired_.front());
+        retired_.pop_front();
+    }
+}
+
+void OrderExecutor::flushUpdates() {
+    if (updates_.empty()) {
+        return;
+    }
+    if (update_handler_) {
+        update_handler_(Span<const OrderUpdate>(updates_.data(), updates_.size()));
+    }
+    updates_.clear();
+}
+
+bool OrderExecutor::tryEnqueue(const OrderCommand& command) {
+    return mpsc_queue_ ? mpsc_queue_->tryPush(command) : spsc_queue_->tryPush(command);
+}
+
+bool OrderExecutor::tryDequeue(OrderCommand& command) {
+    return mpsc_queue_ ? mpsc_queue_->tryPop(command) : spsc_queue_->tryPop(command);
+}
+
+bool OrderExecutor::queueEmpty() const {
+    return mpsc_queue_ ? mpsc_queue_->empty() : spsc_queue_->empty();
 }
 
-} // namespace trading
\ No newline at end of file
+} // namespace trading
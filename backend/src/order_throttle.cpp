@@ -0,0 +1,74 @@
+#include "order_throttle.hpp"
+#include <chrono>
+#include <sys/stat.h>
+
+namespace trading {
+
+bool KillSwitch::pollTriggerFile() {
+    struct stat info;
+    if (trigger_file_.empty() || ::stat(trigger_file_.c_str(), &info) != 0) {
+        return false;
+    }
+    if (!isEngaged()) {
+        engage("trigger file");
+    }
+    return true;
+}
+
+OrderThrottle::OrderThrottle(const Limits& limits, const PriceTable* prices, size_t symbol_capacity)
+    : limits_(limits), prices_(prices), symbol_capacity_(symbol_capacity) {
+    orders_.configure(limits.max_orders_per_second, limits.order_burst);
+    notional_.configure(limits.max_notional_per_second, limits.notional_burst);
+    if (limits.symbol_max_orders_per_second > 0.0 || limits.symbol_max_notional_per_second > 0.0) {
+        symbols_ = std::make_unique<SymbolBuckets[]>(symbol_capacity);
+        for (size_t i = 0; i < symbol_capacity; ++i) {
+            symbols_[i].orders.configure(limits.symbol_max_orders_per_second,
+                                         limits.symbol_order_burst);
+            symbols_[i].notional.configure(limits.symbol_max_notional_per_second,
+                                           limits.symbol_notional_burst);
+        }
+    }
+}
+
+RiskRejectReason OrderThrottle::check(const Order& order) {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return check(order, std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+RiskRejectReason OrderThrottle::check(const Order& order, int64_t now_ns) {
+    if (kill_switch_.isEngaged()) {
+        return RiskRejectReason::KILL_SWITCH;
+    }
+
+    double price = order.getPrice();
+    if (price == 0.0 && prices_) {
+        price = prices_->getLastPrice(order.getSymbol());
+    }
+    double notional = order.getQuantity() * price;
+
+    // Take from each bucket in turn, handing tokens back if a later one refuses
+    if (!orders_.tryAcquire(1.0, now_ns)) {
+        return RiskRejectReason::ORDER_RATE;
+    }
+    if (!notional_.tryAcquire(notional, now_ns)) {
+        orders_.refund(1.0);
+        return RiskRejectReason::NOTIONAL_RATE;
+    }
+    if (symbols_ && order.getSymbol() < symbol_capacity_) {
+        SymbolBuckets& buckets = symbols_[order.getSymbol()];
+        if (!buckets.orders.tryAcquire(1.0, now_ns)) {
+            orders_.refund(1.0);
+            notional_.refund(notional);
+            return RiskRejectReason::ORDER_RATE;
+        }
+        if (!buckets.notional.tryAcquire(notional, now_ns)) {
+            buckets.orders.refund(1.0);
+            orders_.refund(1.0);
+            notional_.refund(notional);
+            return RiskRejectReason::NOTIONAL_RATE;
+        }
+    }
+    return RiskRejectReason::NONE;
+}
+
+} // namespace trading
@@ -0,0 +1,264 @@
+#include "parameter_sweep.hpp"
+#include "common/philox.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace trading {
+
+namespace {
+    constexpr double kInvalidScore = -std::numeric_limits<double>::infinity();
+
+    // Sequential draws from a counter RNG; the sequence depends only on
+    // the seed, never on thread timing
+    class Draws {
+    public:
+        explicit Draws(uint64_t seed) : rng_(seed) {}
+
+        double uniform() { return Philox4x32::toUniform(next()[0]); }
+        double normal() { return rng_.normals(counter_++, 0)[0]; }
+        size_t index(size_t count) { return std::min(count - 1, static_cast<size_t>(uniform() * count)); }
+
+    private:
+        Philox4x32::Counter next() {
+            uint64_t counter = counter_++;
+            return rng_({static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 1, 0});
+        }
+
+        Philox4x32 rng_;
+        uint64_t counter_ = 0;
+    };
+
+    size_t stepCount(const ParameterRange& range) {
+        if (range.step <= 0.0 || range.max < range.min) {
+            throw std::invalid_argument("Invalid range for parameter " + range.name);
+        }
+        return static_cast<size_t>(std::floor((range.max - range.min) / range.step + 1e-9)) + 1;
+    }
+
+    // Snaps to the range's step grid and bounds
+    double snap(const ParameterRange& range, double value) {
+        double steps = std::round((value - range.min) / range.step);
+        double snapped = std::clamp(range.min + steps * range.step, range.min, range.max);
+        return range.integer ? std::round(snapped) : snapped;
+    }
+
+    std::vector<double> randomPoint(const SweepSpec& spec, Draws& draws) {
+        std::vector<double> point;
+        point.reserve(spec.parameters.size());
+        for (const auto& range : spec.parameters) {
+            point.push_back(snap(range, range.min + draws.uniform() * (range.max - range.min)));
+        }
+        return point;
+    }
+
+    bool bestFirst(const SweepEvaluation& a, const SweepEvaluation& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        return a.parameters < b.parameters;
+    }
+
+    // Drops refused parameter sets and sorts best first
+    std::vector<SweepEvaluation> rank(std::vector<SweepEvaluation> evaluations) {
+        evaluations.erase(std::remove_if(evaluations.begin(), evaluations.end(),
+                                         [](const SweepEvaluation& e) { return e.score == kInvalidScore; }),
+                          evaluations.end());
+        std::sort(evaluations.begin(), evaluations.end(), bestFirst);
+        return evaluations;
+    }
+}
+
+ParameterSweep::ParameterSweep(StrategyFactory factory, const Options& options)
+    : factory_(std::move(factory)), options_(options) {
+    // Only the summary is kept per evaluation
+    options_.backtest.record_trades = false;
+    options_.backtest.equity_interval = std::chrono::nanoseconds(0);
+    if (!options_.objective) {
+        options_.objective = [](const BacktestResult& result) { return result.total_return; };
+    }
+}
+
+std::vector<SweepEvaluation> ParameterSweep::run(const SweepSpec& spec, Span<const MarketData> ticks) const {
+    if (spec.parameters.empty()) {
+        throw std::invalid_argument("Parameter sweep needs at least one parameter");
+    }
+    WorkStealingPool pool(options_.threads);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<SweepEvaluation> evaluations;
+    switch (spec.mode) {
+        case SweepSpec::Mode::GRID:
+            evaluations = rank(evaluate(pool, gridPoints(spec), ticks));
+            break;
+        case SweepSpec::Mode::RANDOM: {
+            Draws draws(spec.seed);
+            std::vector<std::vector<double>> points;
+            points.reserve(spec.samples);
+            for (size_t i = 0; i < spec.samples; ++i) {
+                points.push_back(randomPoint(spec, draws));
+            }
+            evaluations = rank(evaluate(pool, points, ticks));
+            break;
+        }
+        case SweepSpec::Mode::GENETIC:
+            evaluations = runGenetic(pool, spec, ticks);
+            break;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    spdlog::info("Parameter sweep: {} evaluations on {} threads in {:.2f}s, best score {:.4f}",
+                 evaluations.size(), pool.size(), elapsed,
+                 evaluations.empty() ? 0.0 : evaluations.front().score);
+    return evaluations;
+}
+
+std::vector<std::vector<double>> ParameterSweep::gridPoints(const SweepSpec& spec) {
+    std::vector<size_t> counts;
+    size_t total = 1;
+    for (const auto& range : spec.parameters) {
+        counts.push_back(stepCount(range));
+        total *= counts.back();
+    }
+
+    std::vector<std::vector<double>> points;
+    points.reserve(total);
+    std::vector<size_t> digits(counts.size(), 0);
+    for (size_t n = 0; n < total; ++n) {
+        std::vector<double> point(counts.size());
+        for (size_t i = 0; i < counts.size(); ++i) {
+            const ParameterRange& range = spec.parameters[i];
+            point[i] = snap(range, range.min + static_cast<double>(digits[i]) * range.step);
+        }
+        points.push_back(std::move(point));
+        // Odometer increment, last parameter fastest
+        for (size_t i = counts.size(); i-- > 0;) {
+            if (++digits[i] < counts[i]) {
+                break;
+            }
+            digits[i] = 0;
+        }
+    }
+    return points;
+}
+
+std::vector<SweepEvaluation> ParameterSweep::evaluate(WorkStealingPool& pool,
+                                                      const std::vector<std::vector<double>>& points,
+                                                      Span<const MarketData> ticks) const {
+    // Each task writes only its own slot
+    std::vector<SweepEvaluation> evaluations(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        pool.submit([this, &points, &evaluations, ticks, i] {
+            SweepEvaluation& evaluation = evaluations[i];
+            evaluation.parameters = points[i];
+            std::unique_ptr<Strategy> strategy = factory_(points[i]);
+            if (!strategy) {
+                evaluation.score = kInvalidScore;
+                return;
+            }
+            BacktestEngine engine(*strategy, options_.backtest);
+            evaluation.result = engine.run(ticks);
+            evaluation.score = options_.objective(evaluation.result);
+            if (std::isnan(evaluation.score)) {
+                evaluation.score = kInvalidScore;
+            }
+        });
+    }
+    pool.wait();
+    return evaluations;
+}
+
+std::vector<SweepEvaluation> ParameterSweep::runGenetic(WorkStealingPool& pool, const SweepSpec& spec,
+                                                        Span<const MarketData> ticks) const {
+    const SweepSpec::Genetic& genetic = spec.genetic;
+    if (genetic.population == 0 || genetic.tournament == 0) {
+        throw std::invalid_argument("Genetic search needs a population and tournament size");
+    }
+    Draws draws(spec.seed);
+    // Every parameter set is evaluated once, however often it reappears
+    std::map<std::vector<double>, SweepEvaluation> evaluated;
+
+    std::vector<std::vector<double>> population;
+    for (size_t i = 0; i < genetic.population; ++i) {
+        population.push_back(randomPoint(spec, draws));
+    }
+
+    for (size_t generation = 0;; ++generation) {
+        std::vector<std::vector<double>> fresh;
+        for (const auto& individual : population) {
+            if (evaluated.find(individual) == evaluated.end() &&
+                std::find(fresh.begin(), fresh.end(), individual) == fresh.end()) {
+                fresh.push_back(individual);
+            }
+        }
+        for (auto& evaluation : evaluate(pool, fresh, ticks)) {
+            evaluated.emplace(evaluation.parameters, std::move(evaluation));
+        }
+        if (generation + 1 >= genetic.generations) {
+            break;
+        }
+
+        // Rank this generation, then breed the next from it
+        std::sort(population.begin(), population.end(),
+                  [&](const std::vector<double>& a, const std::vector<double>& b) {
+                      return bestFirst(evaluated.at(a), evaluated.at(b));
+                  });
+        auto select = [&]() -> const std::vector<double>& {
+            size_t best = draws.index(population.size());
+            for (size_t round = 1; round < genetic.tournament; ++round) {
+                best = std::min(best, draws.index(population.size()));
+            }
+            return population[best];
+        };
+
+        std::vector<std::vector<double>> next(population.begin(),
+                                              population.begin() + std::min(genetic.elite, population.size()));
+        while (next.size() < genetic.population) {
+            std::vector<double> child = select();
+            if (draws.uniform() < genetic.crossover_rate) {
+                const std::vector<double>& other = select();
+                for (size_t i = 0; i < child.size(); ++i) {
+                    if (draws.uniform() < 0.5) {
+                        child[i] = other[i];
+                    }
+                }
+            }
+            for (size_t i = 0; i < child.size(); ++i) {
+                if (draws.uniform() < genetic.mutation_rate) {
+                    const ParameterRange& range = spec.parameters[i];
+                    double width = std::max(range.max - range.min, range.step);
+                    child[i] = snap(range, child[i] + draws.normal() * genetic.mutation_scale * width);
+                }
+            }
+            next.push_back(std::move(child));
+        }
+        population = std::move(next);
+    }
+
+    std::vector<SweepEvaluation> evaluations;
+    evaluations.reserve(evaluated.size());
+    for (auto& entry : evaluated) {
+        evaluations.push_back(std::move(entry.second));
+    }
+    return rank(std::move(evaluations));
+}
+
+ParameterSweep::StrategyFactory movingAverageFactory() {
+    return [](const std::vector<double>& parameters) -> std::unique_ptr<Strategy> {
+        if (parameters.size() != 2) {
+            return nullptr;
+        }
+        int short_period = static_cast<int>(parameters[0]);
+        int long_period = static_cast<int>(parameters[1]);
+        if (short_period <= 0 || long_period <= short_period) {
+            return nullptr;
+        }
+        return std::make_unique<MovingAverageStrategy>(short_period, long_period);
+    };
+}
+
+} // namespace trading
@@ -0,0 +1,547 @@
+// Python module trading_native: the C++ backtest engine and strategies.
+// Built as a separate extension by pybind11_add_module, not part of
+// trading_core.
+#include "backtest_engine.hpp"
+#include "historical_stream.hpp"
+#include "parameter_sweep.hpp"
+#include "tick_file.hpp"
+#include "tick_store.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace py = pybind11;
+using namespace trading;
+
+namespace {
+
+// Lets Python subclasses implement Strategy. Each callback takes the GIL,
+// so a Python strategy runs at Python speed; the native ones do not.
+class PyStrategy : public Strategy {
+public:
+    void initialize() override {
+        PYBIND11_OVERRIDE_PURE(void, Strategy, initialize);
+    }
+    std::vector<Signal> onMarketData(const MarketData& data) override {
+        PYBIND11_OVERRIDE_PURE_NAME(std::vector<Signal>, Strategy, "on_market_data", onMarketData, data);
+    }
+    void onOrderUpdate(const Order& order) override {
+        PYBIND11_OVERRIDE_PURE_NAME(void, Strategy, "on_order_update", onOrderUpdate, order);
+    }
+};
+
+template <typename T>
+using Column = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+// Replays columns of ticks without building an intermediate vector. The
+// GIL is released for the whole run.
+BacktestResult runColumns(BacktestEngine& engine, const Column<int64_t>& timestamps_ns,
+                          const Column<int32_t>& symbol_index, const Column<double>& prices,
+                          const Column<double>& volumes, const std::vector<std::string>& symbols) {
+    size_t count = static_cast<size_t>(timestamps_ns.size());
+    if (static_cast<size_t>(symbol_index.size()) != count || static_cast<size_t>(prices.size()) != count ||
+        static_cast<size_t>(volumes.size()) != count) {
+        throw std::invalid_argument("Tick columns must have the same length");
+    }
+    std::vector<SymbolId> ids;
+    ids.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        ids.push_back(internSymbol(symbol));
+    }
+
+    const int64_t* times = timestamps_ns.data();
+    const int32_t* index = symbol_index.data();
+    const double* price = prices.data();
+    const double* volume = volumes.data();
+
+    // Checked up front so a bad row cannot abort a run midway
+    for (size_t i = 0; i < count; ++i) {
+        if (index[i] < 0 || static_cast<size_t>(index[i]) >= ids.size()) {
+            throw std::out_of_range("Symbol index out of range at row " + std::to_string(i));
+        }
+    }
+
+    py::gil_scoped_release release;
+    engine.begin();
+    MarketData tick;
+    for (size_t i = 0; i < count; ++i) {
+        tick.symbol_id = ids[index[i]];
+        tick.last_price = price[i];
+        tick.volume = volume[i];
+        tick.timestamp = fromEpochNanos(times[i]);
+        engine.onTick(tick);
+    }
+    return engine.finish();
+}
+
+// Tick columns as MarketData records, for writing a TickFile
+std::vector<MarketData> ticksFromColumns(const Column<int64_t>& timestamps_ns, const Column<int32_t>& symbol_index,
+                                         const Column<double>& prices, const Column<double>& volumes,
+                                         const std::vector<std::string>& symbols) {
+    size_t count = static_cast<size_t>(timestamps_ns.size());
+    if (static_cast<size_t>(symbol_index.size()) != count || static_cast<size_t>(prices.size()) != count ||
+        static_cast<size_t>(volumes.size()) != count) {
+        throw std::invalid_argument("Tick columns must have the same length");
+    }
+    std::vector<MarketData> ticks(count);
+    for (size_t i = 0; i < count; ++i) {
+        int32_t index = symbol_index.at(i);
+        if (index < 0 || static_cast<size_t>(index) >= symbols.size()) {
+            throw std::out_of_range("Symbol index out of range at row " + std::to_string(i));
+        }
+        ticks[i].symbol_id = internSymbol(symbols[index]);
+        ticks[i].last_price = prices.at(i);
+        ticks[i].volume = volumes.at(i);
+        ticks[i].timestamp = fromEpochNanos(timestamps_ns.at(i));
+    }
+    return ticks;
+}
+
+// Appends one symbol's columns; open/high/low all given makes a bar chunk
+void appendStoreColumns(TickStoreWriter& writer, const std::string& symbol, const Column<int64_t>& timestamps_ns,
+                        const Column<double>& prices, const Column<double>& volumes,
+                        const std::optional<Column<double>>& open, const std::optional<Column<double>>& high,
+                        const std::optional<Column<double>>& low) {
+    size_t count = static_cast<size_t>(timestamps_ns.size());
+    bool bars = open && high && low;
+    if (static_cast<size_t>(prices.size()) != count || static_cast<size_t>(volumes.size()) != count ||
+        (bars && (static_cast<size_t>(open->size()) != count || static_cast<size_t>(high->size()) != count ||
+                  static_cast<size_t>(low->size()) != count))) {
+        throw std::invalid_argument("Tick columns must have the same length");
+    }
+    SymbolId symbol_id = internSymbol(symbol);
+    std::vector<MarketData> ticks(count);
+    for (size_t i = 0; i < count; ++i) {
+        ticks[i].symbol_id = symbol_id;
+        ticks[i].timestamp = fromEpochNanos(timestamps_ns.at(i));
+        ticks[i].last_price = prices.at(i);
+        ticks[i].volume = volumes.at(i);
+        if (bars) {
+            ticks[i].open = open->at(i);
+            ticks[i].high = high->at(i);
+            ticks[i].low = low->at(i);
+        }
+    }
+    py::gil_scoped_release release;
+    writer.append(ticks, bars ? TickStoreWriter::Layout::BARS : TickStoreWriter::Layout::TICKS);
+}
+
+template <typename T>
+py::array_t<T> toArray(const std::vector<T>& values) {
+    py::array_t<T> array(values.size());
+    std::memcpy(array.mutable_data(), values.data(), values.size() * sizeof(T));
+    return array;
+}
+
+// A symbol's range as one array per column; open/high/low only for bars
+py::dict storeColumns(const TickStore& store, const std::string& symbol, std::optional<int64_t> start_ns,
+                      std::optional<int64_t> end_ns) {
+    Timestamp start = start_ns ? fromEpochNanos(*start_ns) : Timestamp::min();
+    Timestamp end = end_ns ? fromEpochNanos(*end_ns) : Timestamp::max();
+    auto entries = store.find(internSymbol(symbol), start, end);
+    bool bars = !entries.empty();
+    for (const auto& entry : entries) {
+        bars = bars && entry.columns[static_cast<size_t>(tick_store::Column::OPEN)].offset != 0;
+    }
+
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices, volumes, open, high, low;
+    {
+        py::gil_scoped_release release;
+        TickStore::Buffer buffer;
+        for (const auto& entry : entries) {
+            TickStore::Chunk chunk = store.load(entry, buffer, start, end);
+            timestamps.insert(timestamps.end(), chunk.timestamps.begin(), chunk.timestamps.end());
+            prices.insert(prices.end(), chunk.prices.begin(), chunk.prices.end());
+            volumes.insert(volumes.end(), chunk.volumes.begin(), chunk.volumes.end());
+            if (bars) {
+                open.insert(open.end(), chunk.open.begin(), chunk.open.end());
+                high.insert(high.end(), chunk.high.begin(), chunk.high.end());
+                low.insert(low.end(), chunk.low.begin(), chunk.low.end());
+            }
+        }
+    }
+    py::dict columns;
+    columns["timestamp_ns"] = toArray(timestamps);
+    columns["price"] = toArray(prices);
+    columns["volume"] = toArray(volumes);
+    if (bars) {
+        columns["open"] = toArray(open);
+        columns["high"] = toArray(high);
+        columns["low"] = toArray(low);
+    }
+    return columns;
+}
+
+// The stream's next batch as columns; symbol_index refers to
+// stream.symbols. Raises StopIteration at the end of the range.
+py::dict streamBatch(HistoricalStream& stream) {
+    Span<const MarketData> batch;
+    {
+        py::gil_scoped_release release;
+        batch = stream.next();
+    }
+    if (batch.empty()) {
+        throw py::stop_iteration();
+    }
+
+    size_t count = batch.size();
+    py::array_t<int64_t> timestamp(count);
+    py::array_t<int32_t> symbol_index(count);
+    py::array_t<double> price(count), open(count), high(count), low(count), volume(count);
+    int64_t* times = timestamp.mutable_data();
+    int32_t* index = symbol_index.mutable_data();
+    double* prices = price.mutable_data();
+    double* opens = open.mutable_data();
+    double* highs = high.mutable_data();
+    double* lows = low.mutable_data();
+    double* volumes = volume.mutable_data();
+    {
+        py::gil_scoped_release release;
+        std::unordered_map<SymbolId, int32_t> positions;
+        for (size_t i = 0; i < stream.symbols().size(); ++i) {
+            positions.emplace(stream.symbols()[i], static_cast<int32_t>(i));
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const MarketData& tick = batch[i];
+            times[i] = toEpochNanos(tick.timestamp);
+            index[i] = positions[tick.symbol_id];
+            prices[i] = tick.last_price;
+            opens[i] = tick.open;
+            highs[i] = tick.high;
+            lows[i] = tick.low;
+            volumes[i] = tick.volume;
+        }
+    }
+    py::dict columns;
+    columns["timestamp_ns"] = timestamp;
+    columns["symbol_index"] = symbol_index;
+    columns["price"] = price;
+    columns["open"] = open;
+    columns["high"] = high;
+    columns["low"] = low;
+    columns["volume"] = volume;
+    return columns;
+}
+
+py::dict equityColumns(const BacktestResult& result) {
+    size_t count = result.equity_curve.size();
+    py::array_t<int64_t> timestamp(count);
+    py::array_t<double> total_value(count), cash(count), drawdown(count);
+    for (size_t i = 0; i < count; ++i) {
+        const EquityPoint& point = result.equity_curve[i];
+        timestamp.mutable_at(i) = toEpochNanos(point.timestamp);
+        total_value.mutable_at(i) = point.total_value;
+        cash.mutable_at(i) = point.cash;
+        drawdown.mutable_at(i) = point.drawdown;
+    }
+    py::dict columns;
+    columns["timestamp_ns"] = timestamp;
+    columns["total_value"] = total_value;
+    columns["cash"] = cash;
+    columns["drawdown"] = drawdown;
+    return columns;
+}
+
+py::dict tradeColumns(const BacktestResult& result) {
+    size_t count = result.trades.size();
+    py::array_t<int64_t> timestamp(count), order_id(count);
+    py::array_t<double> quantity(count), price(count), commission(count);
+    py::list symbol, side;
+    for (size_t i = 0; i < count; ++i) {
+        const TradeRecord& trade = result.trades[i];
+        timestamp.mutable_at(i) = toEpochNanos(trade.timestamp);
+        order_id.mutable_at(i) = static_cast<int64_t>(trade.order_id);
+        quantity.mutable_at(i) = trade.quantity;
+        price.mutable_at(i) = trade.price;
+        commission.mutable_at(i) = trade.commission;
+        symbol.append(symbolName(trade.symbol));
+        side.append(trade.side == OrderSide::BUY ? "buy" : "sell");
+    }
+    py::dict columns;
+    columns["timestamp_ns"] = timestamp;
+    columns["symbol"] = symbol;
+    columns["side"] = side;
+    columns["quantity"] = quantity;
+    columns["price"] = price;
+    columns["commission"] = commission;
+    columns["order_id"] = order_id;
+    return columns;
+}
+
+} // namespace
+
+PYBIND11_MODULE(trading_native, m) {
+    m.doc() = "Native trading engine components";
+
+    py::enum_<OrderSide>(m, "OrderSide")
+        .value("BUY", OrderSide::BUY)
+        .value("SELL", OrderSide::SELL);
+    py::enum_<OrderType>(m, "OrderType")
+        .value("MARKET", OrderType::MARKET)
+        .value("LIMIT", OrderType::LIMIT)
+        .value("STOP", OrderType::STOP)
+        .value("STOP_LIMIT", OrderType::STOP_LIMIT);
+    py::enum_<OrderStatus>(m, "OrderStatus")
+        .value("PENDING", OrderStatus::PENDING)
+        .value("FILLED", OrderStatus::FILLED)
+        .value("PARTIALLY_FILLED", OrderStatus::PARTIALLY_FILLED)
+        .value("CANCELLED", OrderStatus::CANCELLED)
+        .value("REJECTED", OrderStatus::REJECTED);
+    py::enum_<QueuePosition>(m, "QueuePosition")
+        .value("FRONT", QueuePosition::FRONT)
+        .value("BEHIND", QueuePosition::BEHIND)
+        .value("THROUGH_ONLY", QueuePosition::THROUGH_ONLY);
+
+    m.def("intern_symbol", &internSymbol);
+    m.def("symbol_name", &symbolName);
+
+    py::class_<MarketData>(m, "MarketData")
+        .def(py::init<>())
+        .def_readwrite("symbol_id", &MarketData::symbol_id)
+        .def_readwrite("last_price", &MarketData::last_price)
+        .def_readwrite("open", &MarketData::open)
+        .def_readwrite("high", &MarketData::high)
+        .def_readwrite("low", &MarketData::low)
+        .def_readwrite("volume", &MarketData::volume)
+        .def_readwrite("timestamp", &MarketData::timestamp);
+
+    py::class_<Order>(m, "Order")
+        .def_property_readonly("order_id", &Order::getOrderId)
+        .def_property_readonly("symbol_id", &Order::getSymbol)
+        .def_property_readonly("side", &Order::getSide)
+        .def_property_readonly("type", &Order::getType)
+        .def_property_readonly("status", &Order::getStatus)
+        .def_property_readonly("quantity", &Order::getQuantity)
+        .def_property_readonly("filled_quantity", &Order::getFilledQuantity)
+        .def_property_readonly("average_fill_price", &Order::getAverageFillPrice);
+
+    py::class_<Strategy, PyStrategy> strategy(m, "Strategy");
+    strategy
+        .def(py::init<>())
+        .def("initialize", &Strategy::initialize)
+        .def("on_market_data", &Strategy::onMarketData)
+        .def("on_order_update", &Strategy::onOrderUpdate);
+    py::class_<Strategy::Signal>(strategy, "Signal")
+        .def(py::init<>())
+        .def(py::init([](SymbolId symbol, OrderSide side, double strength, Timestamp timestamp) {
+                 return Strategy::Signal{symbol, side, strength, timestamp};
+             }),
+             py::arg("symbol"), py::arg("side"), py::arg("strength"), py::arg("timestamp") = Timestamp())
+        .def_readwrite("symbol", &Strategy::Signal::symbol)
+        .def_readwrite("side", &Strategy::Signal::side)
+        .def_readwrite("strength", &Strategy::Signal::strength)
+        .def_readwrite("timestamp", &Strategy::Signal::timestamp);
+
+    py::class_<MovingAverageStrategy, Strategy>(m, "MovingAverageStrategy")
+        .def(py::init<int, int>(), py::arg("short_period") = 10, py::arg("long_period") = 30);
+
+    py::class_<RiskLimits>(m, "RiskLimits")
+        .def(py::init([](double max_position_size, double max_drawdown, double max_leverage,
+                         double daily_loss_limit, double position_concentration) {
+                 return RiskLimits{max_position_size, max_drawdown, max_leverage,
+                                   daily_loss_limit, position_concentration};
+             }),
+             py::arg("max_position_size") = 1.0, py::arg("max_drawdown") = 1.0,
+             py::arg("max_leverage") = 10.0, py::arg("daily_loss_limit") = 1.0,
+             py::arg("position_concentration") = 1.0,
+             "Limits as fractions of portfolio value (max_leverage as a multiple); "
+             "daily_loss_limit is relative to the session start value")
+        .def_readwrite("max_position_size", &RiskLimits::max_position_size)
+        .def_readwrite("max_drawdown", &RiskLimits::max_drawdown)
+        .def_readwrite("max_leverage", &RiskLimits::max_leverage)
+        .def_readwrite("daily_loss_limit", &RiskLimits::daily_loss_limit)
+        .def_readwrite("position_concentration", &RiskLimits::position_concentration);
+
+    py::class_<LatencyModel>(m, "LatencyModel")
+        .def(py::init<>())
+        .def_readwrite("order_latency", &LatencyModel::order_latency)
+        .def_readwrite("report_latency", &LatencyModel::report_latency)
+        .def_readwrite("jitter", &LatencyModel::jitter)
+        .def_readwrite("seed", &LatencyModel::seed);
+
+    py::class_<MatchingEngine::Options>(m, "MatchingOptions")
+        .def(py::init<>())
+        .def_readwrite("tick_size", &MatchingEngine::Options::tick_size)
+        .def_readwrite("outside_liquidity", &MatchingEngine::Options::outside_liquidity)
+        .def_readwrite("queue_position", &MatchingEngine::Options::queue_position)
+        .def_readwrite("queue_ahead", &MatchingEngine::Options::queue_ahead);
+
+    py::class_<BacktestEngine::Options>(m, "BacktestOptions")
+        .def(py::init<>())
+        .def_readwrite("initial_capital", &BacktestEngine::Options::initial_capital)
+        .def_readwrite("position_size_limit", &BacktestEngine::Options::position_size_limit)
+        .def_readwrite("commission_rate", &BacktestEngine::Options::commission_rate)
+        .def_readwrite("limits", &BacktestEngine::Options::limits)
+        .def_property("matching",
+            [](const BacktestEngine::Options& options) { return options.exchange.matching; },
+            [](BacktestEngine::Options& options, const MatchingEngine::Options& matching) {
+                options.exchange.matching = matching;
+            })
+        .def_property("latency",
+            [](const BacktestEngine::Options& options) { return options.exchange.latency; },
+            [](BacktestEngine::Options& options, const LatencyModel& latency) {
+                options.exchange.latency = latency;
+            })
+        .def_readwrite("order_pool_capacity", &BacktestEngine::Options::order_pool_capacity)
+        .def_readwrite("equity_interval", &BacktestEngine::Options::equity_interval)
+        .def_readwrite("record_trades", &BacktestEngine::Options::record_trades);
+
+    py::class_<BacktestResult>(m, "BacktestResult")
+        .def_readonly("initial_capital", &BacktestResult::initial_capital)
+        .def_readonly("final_value", &BacktestResult::final_value)
+        .def_readonly("total_return", &BacktestResult::total_return)
+        .def_readonly("max_drawdown", &BacktestResult::max_drawdown)
+        .def_readonly("realized_pnl", &BacktestResult::realized_pnl)
+        .def_readonly("commission", &BacktestResult::commission)
+        .def_readonly("events", &BacktestResult::events)
+        .def_readonly("orders_submitted", &BacktestResult::orders_submitted)
+        .def_readonly("orders_rejected", &BacktestResult::orders_rejected)
+        .def_readonly("fills", &BacktestResult::fills)
+        .def_readonly("elapsed_seconds", &BacktestResult::elapsed_seconds)
+        // Column dicts of NumPy arrays, ready for pandas.DataFrame
+        .def_property_readonly("equity_curve", &equityColumns)
+        .def_property_readonly("trades", &tradeColumns);
+
+    m.def("write_tick_file",
+          [](const std::string& path, const Column<int64_t>& timestamps_ns, const Column<int32_t>& symbol_index,
+             const Column<double>& prices, const Column<double>& volumes, const std::vector<std::string>& symbols) {
+              TickFile::write(path, ticksFromColumns(timestamps_ns, symbol_index, prices, volumes, symbols));
+          },
+          py::arg("path"), py::arg("timestamps_ns"), py::arg("symbol_index"), py::arg("prices"),
+          py::arg("volumes"), py::arg("symbols"),
+          "Writes tick columns to a file that sweeps map instead of loading");
+
+    py::class_<TickStoreWriter>(m, "TickStoreWriter")
+        .def(py::init([](const std::string& path, bool compress) {
+                 return std::make_unique<TickStoreWriter>(
+                     path, compress ? TickStoreWriter::Compression::PACKED : TickStoreWriter::Compression::NONE);
+             }),
+             py::arg("path"), py::arg("compress") = true)
+        .def("append", &appendStoreColumns,
+             py::arg("symbol"), py::arg("timestamps_ns"), py::arg("prices"), py::arg("volumes"),
+             py::arg("open") = py::none(), py::arg("high") = py::none(), py::arg("low") = py::none(),
+             "Appends one symbol's ticks in time order; pass open/high/low to store bars")
+        .def("finish", &TickStoreWriter::finish);
+
+    py::class_<TickStore>(m, "TickStore")
+        .def(py::init<const std::string&>(), py::arg("path"))
+        .def_property_readonly("symbols",
+            [](const TickStore& store) {
+                std::vector<std::string> names;
+                for (SymbolId symbol : store.symbols()) {
+                    names.push_back(symbolName(symbol));
+                }
+                return names;
+            })
+        .def_property_readonly("chunk_count", &TickStore::chunkCount)
+        .def("tick_count",
+             [](const TickStore& store, const std::string& symbol) { return store.tickCount(internSymbol(symbol)); })
+        .def("read", &storeColumns,
+             py::arg("symbol"), py::arg("start_ns") = py::none(), py::arg("end_ns") = py::none(),
+             "Columns of symbol in [start_ns, end_ns] as NumPy arrays");
+
+    py::class_<HistoricalStream>(m, "HistoricalStream")
+        .def(py::init([](const std::string& path, const std::vector<std::string>& symbols,
+                         std::optional<int64_t> start_ns, std::optional<int64_t> end_ns, size_t batch_size,
+                         size_t prefetch) {
+                 std::vector<SymbolId> ids;
+                 for (const auto& symbol : symbols) {
+                     ids.push_back(internSymbol(symbol));
+                 }
+                 HistoricalStream::Options options;
+                 options.batch_size = batch_size;
+                 options.prefetch = prefetch;
+                 return std::make_unique<HistoricalStream>(
+                     path, std::move(ids), start_ns ? fromEpochNanos(*start_ns) : Timestamp::min(),
+                     end_ns ? fromEpochNanos(*end_ns) : Timestamp::max(), options);
+             }),
+             py::arg("path"), py::arg("symbols"), py::arg("start_ns") = py::none(), py::arg("end_ns") = py::none(),
+             py::arg("batch_size") = HistoricalStream::Options().batch_size,
+             py::arg("prefetch") = HistoricalStream::Options().prefetch)
+        .def_property_readonly("symbols",
+            [](const HistoricalStream& stream) {
+                std::vector<std::string> names;
+                for (SymbolId symbol : stream.symbols()) {
+                    names.push_back(symbolName(symbol));
+                }
+                return names;
+            })
+        .def("__iter__", [](py::object self) { return self; })
+        .def("__next__", &streamBatch,
+             "Next batch of ticks in time order as NumPy columns; symbol_index refers to symbols");
+
+    py::class_<ParameterRange>(m, "ParameterRange")
+        .def(py::init([](std::string name, double min, double max, double step, bool integer) {
+                 return ParameterRange{std::move(name), min, max, step, integer};
+             }),
+             py::arg("name"), py::arg("min"), py::arg("max"), py::arg("step") = 1.0, py::arg("integer") = true)
+        .def_readwrite("name", &ParameterRange::name)
+        .def_readwrite("min", &ParameterRange::min)
+        .def_readwrite("max", &ParameterRange::max)
+        .def_readwrite("step", &ParameterRange::step)
+        .def_readwrite("integer", &ParameterRange::integer);
+
+    py::class_<SweepSpec> spec(m, "SweepSpec");
+    py::enum_<SweepSpec::Mode>(spec, "Mode")
+        .value("GRID", SweepSpec::Mode::GRID)
+        .value("RANDOM", SweepSpec::Mode::RANDOM)
+        .value("GENETIC", SweepSpec::Mode::GENETIC);
+    py::class_<SweepSpec::Genetic>(spec, "Genetic")
+        .def(py::init<>())
+        .def_readwrite("population", &SweepSpec::Genetic::population)
+        .def_readwrite("generations", &SweepSpec::Genetic::generations)
+        .def_readwrite("elite", &SweepSpec::Genetic::elite)
+        .def_readwrite("tournament", &SweepSpec::Genetic::tournament)
+        .def_readwrite("crossover_rate", &SweepSpec::Genetic::crossover_rate)
+        .def_readwrite("mutation_rate", &SweepSpec::Genetic::mutation_rate)
+        .def_readwrite("mutation_scale", &SweepSpec::Genetic::mutation_scale);
+    spec.def(py::init<>())
+        .def_readwrite("mode", &SweepSpec::mode)
+        .def_readwrite("parameters", &SweepSpec::parameters)
+        .def_readwrite("samples", &SweepSpec::samples)
+        .def_readwrite("genetic", &SweepSpec::genetic)
+        .def_readwrite("seed", &SweepSpec::seed);
+
+    py::class_<SweepEvaluation>(m, "SweepEvaluation")
+        .def_readonly("parameters", &SweepEvaluation::parameters)
+        .def_readonly("score", &SweepEvaluation::score)
+        .def_readonly("result", &SweepEvaluation::result);
+
+    // Native strategies only: a Python factory would serialize every
+    // evaluation on the GIL
+    m.def("sweep_moving_average",
+          [](const SweepSpec& sweep_spec, const std::string& tick_file, const BacktestEngine::Options& backtest,
+             size_t threads) {
+              TickFile file(tick_file);
+              ParameterSweep::Options options;
+              options.threads = threads;
+              options.backtest = backtest;
+              py::gil_scoped_release release;
+              return ParameterSweep(movingAverageFactory(), options).run(sweep_spec, file.ticks());
+          },
+          py::arg("spec"), py::arg("tick_file"), py::arg("options") = BacktestEngine::Options(),
+          py::arg("threads") = 0,
+          "Sweeps (short_period, long_period) of MovingAverageStrategy over a tick file, best first");
+
+    py::class_<BacktestEngine>(m, "BacktestEngine")
+        .def(py::init<Strategy&, const BacktestEngine::Options&>(),
+             py::arg("strategy"), py::arg("options") = BacktestEngine::Options(),
+             py::keep_alive<1, 2>())
+        .def("run", &runColumns,
+             py::arg("timestamps_ns"), py::arg("symbol_index"), py::arg("prices"),
+             py::arg("volumes"), py::arg("symbols"),
+             "Replays ticks given as columns sorted by time; symbol_index refers to symbols")
+        .def("run_stream",
+             [](BacktestEngine& engine, HistoricalStream& stream) {
+                 py::gil_scoped_release release;
+                 return engine.run(stream);
+             },
+             py::arg("stream"),
+             "Replays a HistoricalStream batch by batch, for ranges too large to load");
+}
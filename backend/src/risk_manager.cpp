@@ -1,92 +1,68 @@
 #include "risk_manager.hpp"
 #include <spdlog/spdlog.h>
-#include <algorithm>
 
 namespace trading {
 
-RiskManager::RiskManager(const RiskLimits& limits) : limits_(limits) {}
-
-bool RiskManager::checkOrderRisk(const Order& order, const Portfolio& portfolio) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    try {
-        // 1. Check single position size limit
-        double position_value = order.getQuantity() * order.getPrice();
-        double portfolio_value = portfolio.getTotalValue(current_prices_);
-        
-        if (position_value / portfolio_value > limits_.max_position_size) {
-            spdlog::warn("Position size limit exceeded for {}", order.getSymbol());
-            return false;
-        }
-        
-        // 2. Check leverage limit
-        double total_exposure = portfolio.getTotalExposure() + position_value;
-        if (total_exposure / portfolio_value > limits_.max_leverage) {
-            spdlog::warn("Leverage limit exceeded");
-            return false;
-        }
-        
-        // 3. Check drawdown limit
-        if (portfolio.getDrawdown() > limits_.max_drawdown) {
-            spdlog::warn("Drawdown limit exceeded");
-            return false;
-        }
-        
-        // 4. Check daily loss limit
-        if (portfolio.getDailyPnL() < -limits_.daily_loss_limit) {
-            spdlog::warn("Daily loss limit exceeded");
-            return false;
-        }
-        
-        // 5. Check concentration limit
-        auto position = portfolio.getPosition(order.getSymbol());
-        double new_position_size = (position ? position->getQuantity() : 0) + order.getQuantity();
-        double new_concentration = new_position_size * order.getPrice() / portfolio_value;
-        
-        if (new_concentration > limits_.position_concentration) {
-            spdlog::warn("Position concentration limit exceeded for {}", order.getSymbol());
-            return false;
-        }
-        
-        // Update risk metrics
-        updateRiskMetrics(portfolio);
-        return true;
-        
-    } catch (const std::exception& e) {
-        spdlog::error("Error in risk check: {}", e.what());
-        return false;
+const char* toString(RiskRejectReason reason) {
+    switch (reason) {
+        case RiskRejectReason::NONE: return "none";
+        case RiskRejectReason::POSITION_SIZE: return "position size";
+        case RiskRejectReason::LEVERAGE: return "leverage";
+        case RiskRejectReason::DRAWDOWN: return "drawdown";
+        case RiskRejectReason::DAILY_LOSS: return "daily loss";
+        case RiskRejectReason::CONCENTRATION: return "concentration";
+        case RiskRejectReason::NO_PRICE: return "no price";
+        case RiskRejectReason::VAR: return "value at risk";
+        case RiskRejectReason::EXPECTED_SHORTFALL: return "expected shortfall";
+        case RiskRejectReason::KILL_SWITCH: return "kill switch";
+        case RiskRejectReason::ORDER_RATE: return "order rate";
+        case RiskRejectReason::NOTIONAL_RATE: return "notional rate";
     }
+    return "unknown";
 }
 
-void RiskManager::updateRiskMetrics(const Portfolio& portfolio) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    try {
-        // Update risk metrics
-        current_metrics_["drawdown"] = portfolio.getDrawdown();
-        current_metrics_["leverage"] = portfolio.getLeverage();
-        current_metrics_["daily_pnl"] = portfolio.getDailyPnL();
-        current_metrics_["concentration"] = portfolio.getConcentration();
-        
-        // Log risk metrics
-        spdlog::debug("Risk metrics updated: drawdown={:.2f}%, leverage={:.2f}x, daily_pnl=${:.2f}",
-            current_metrics_["drawdown"] * 100,
-            current_metrics_["leverage"],
-            current_metrics_["daily_pnl"]);
-            
-    } catch (const std::exception& e) {
-        spdlog::error("Error updating risk metrics: {}", e.what());
+RiskManager::RiskManager(const RiskLimits& limits, const PriceTable* prices)
+    : limits_(limits), prices_(prices) {}
+
+bool RiskManager::checkOrderRisk(const Order& order, const Portfolio& portfolio) {
+    RiskVerdict verdict = checkOrder(order, portfolio);
+    if (!verdict) {
+        spdlog::warn("Order {} for {} rejected: {} limit",
+                     formatOrderId(order.getOrderId()),
+                     symbolName(order.getSymbol()),
+                     toString(verdict.reason));
     }
+    return verdict.accepted();
 }
 
-std::map<std::string, double> RiskManager::getRiskMetrics() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return current_metrics_;
+void RiskManager::updateTailRisk(double var, double expected_shortfall) {
+    tail_risk_.store({var, expected_shortfall});
 }
 
-void RiskManager::updateCurrentPrices(const std::map<std::string, double>& prices) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    current_prices_ = prices;
+void RiskManager::updateRiskMetrics(const Portfolio& portfolio, const VarEstimate& var) {
+    RiskMetrics metrics;
+    metrics.drawdown = portfolio.getDrawdown();
+    metrics.leverage = portfolio.getLeverage();
+    metrics.daily_pnl = portfolio.getDailyPnL();
+    metrics.concentration = portfolio.getConcentration();
+    metrics.total_exposure = portfolio.getTotalExposure();
+    metrics.total_value = portfolio.getTotalValue();
+    metrics.var = var.parametric_var;
+    metrics.cvar = var.parametric_cvar;
+    metrics.historical_var = var.historical_var;
+    metrics.historical_cvar = var.historical_cvar;
+    TailRisk tail = tail_risk_.load();
+    metrics.simulated_var = tail.var;
+    metrics.simulated_expected_shortfall = tail.expected_shortfall;
+    metrics.timestamp = std::chrono::system_clock::now();
+    metrics_.store(metrics);
+    
+    // Log risk metrics
+    spdlog::debug("Risk metrics updated: drawdown={:.2f}%, leverage={:.2f}x, daily_pnl=${:.2f}, var=${:.2f}",
+        metrics.drawdown * 100,
+        metrics.leverage,
+        metrics.daily_pnl,
+        metrics.var);
 }
 
 } // namespace trading
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "simulated_exchange.hpp"
+#include <algorithm>
+
+namespace trading {
+
+SimulatedExchange::SimulatedExchange(const Options& options, const PriceTable* prices)
+    : options_(options)
+    , prices_(prices)
+    , engine_(options.matching)
+    , rng_(options.latency.seed) {
+    engine_.setReportSink([this](const ExecutionReport& execution) {
+        Timestamp due = delay(options_.latency.report_latency, execution.timestamp, last_outbound_due_);
+        outbound_.push_back(PendingReport{due, execution});
+    });
+}
+
+void SimulatedExchange::submit(const Order& order) {
+    Request request;
+    request.type = Request::Type::NEW;
+    request.order = order;
+    enqueue(std::move(request));
+}
+
+void SimulatedExchange::cancel(OrderId order_id) {
+    Request request;
+    request.type = Request::Type::CANCEL;
+    request.order_id = order_id;
+    enqueue(std::move(request));
+}
+
+void SimulatedExchange::replace(OrderId order_id, double quantity, double price) {
+    Request request;
+    request.type = Request::Type::REPLACE;
+    request.order_id = order_id;
+    request.quantity = quantity;
+    request.price = price;
+    enqueue(std::move(request));
+}
+
+void SimulatedExchange::poll() {
+    Timestamp time = now();
+    for (SymbolId symbol : symbols_) {
+        if (engine_.hasOpenOrders(symbol)) {
+            pullTrades(symbol);
+        }
+    }
+    deliverDue(time);
+}
+
+void SimulatedExchange::advanceTo(Timestamp time) {
+    clock_ = std::max(clock_, time);
+    deliverDue(clock_);
+}
+
+void SimulatedExchange::onTrade(SymbolId symbol, double price, double quantity, Timestamp timestamp) {
+    Timestamp time = now();
+    if (options_.simulated_clock) {
+        time = clock_ = std::max(clock_, timestamp);
+    }
+    // Requests that reached the exchange before the trade go first
+    deliverDue(time);
+    engine_.onTrade(symbol, price, quantity, time);
+    deliverDue(time);
+}
+
+Timestamp SimulatedExchange::now() const {
+    return options_.simulated_clock ? clock_ : std::chrono::system_clock::now();
+}
+
+Timestamp SimulatedExchange::delay(std::chrono::nanoseconds latency, Timestamp from, Timestamp& last_due) {
+    auto total = latency;
+    if (options_.latency.jitter.count() > 0) {
+        uint64_t draw = draws_++;
+        auto bits = rng_({static_cast<uint32_t>(draw), static_cast<uint32_t>(draw >> 32), 0, 0});
+        total += std::chrono::nanoseconds(static_cast<int64_t>(
+            Philox4x32::toUniform(bits[0]) * static_cast<double>(options_.latency.jitter.count())));
+    }
+    // Messages on one leg arrive in the order they were sent
+    Timestamp due = std::max(from + std::chrono::duration_cast<Timestamp::duration>(total), last_due);
+    last_due = due;
+    return due;
+}
+
+void SimulatedExchange::enqueue(Request request) {
+    request.due = delay(options_.latency.order_latency, now(), last_inbound_due_);
+    inbound_.push_back(std::move(request));
+}
+
+void SimulatedExchange::deliverDue(Timestamp time) {
+    while (!inbound_.empty() && inbound_.front().due <= time) {
+        Request request = std::move(inbound_.front());
+        inbound_.pop_front();
+        switch (request.type) {
+            case Request::Type::NEW:
+                track(request.order.getSymbol());
+                pullTrades(request.order.getSymbol());
+                engine_.submit(request.order, request.due);
+                break;
+            case Request::Type::CANCEL:
+                engine_.cancel(request.order_id, request.due);
+                break;
+            case Request::Type::REPLACE:
+                engine_.replace(request.order_id, request.quantity, request.price, request.due);
+                break;
+        }
+    }
+    while (!outbound_.empty() && outbound_.front().due <= time) {
+        ExecutionReport execution = outbound_.front().report;
+        outbound_.pop_front();
+        report(execution);
+    }
+}
+
+void SimulatedExchange::track(SymbolId symbol) {
+    if (symbol >= SymbolTable::kMaxSymbols ||
+        std::find(symbols_.begin(), symbols_.end(), symbol) != symbols_.end()) {
+        return;
+    }
+    symbols_.push_back(symbol);
+    if (symbol >= seen_trades_.size()) {
+        seen_trades_.resize(symbol + 1);
+    }
+}
+
+void SimulatedExchange::pullTrades(SymbolId symbol) {
+    Quote quote;
+    if (!prices_ || symbol >= seen_trades_.size() || !prices_->getQuote(symbol, quote) ||
+        quote.timestamp <= seen_trades_[symbol]) {
+        return;
+    }
+    seen_trades_[symbol] = quote.timestamp;
+    engine_.onTrade(symbol, quote.last_price, quote.volume, now());
+}
+
+} // namespace trading
@@ -1,43 +1,39 @@
 #include "strategy.hpp"
-#include <numeric>
 #include <spdlog/spdlog.h>
+#include <stdexcept>
 
 namespace trading {
 
 MovingAverageStrategy::MovingAverageStrategy(int short_period, int long_period)
     : short_period_(short_period)
     , long_period_(long_period) {
+    if (short_period <= 0 || long_period < short_period) {
+        throw std::invalid_argument("Invalid moving average periods");
+    }
 }
 
 void MovingAverageStrategy::initialize() {
-    prices_.clear();
+    states_.clear();
 }
 
 std::vector<Strategy::Signal> MovingAverageStrategy::onMarketData(
     const MarketData& data) {
     
     std::vector<Signal> signals;
-    prices_.push_back(data.last_price);
+    SymbolState& state = states_.getOrCreate(data.symbol_id, short_period_, long_period_);
+    state.short_window.push(data.last_price);
+    state.long_window.push(data.last_price);
     
-    if (prices_.size() < static_cast<size_t>(long_period_)) {
+    if (!state.long_window.full()) {
         return signals;
     }
     
-    // Calculate moving averages
-    double short_ma = std::accumulate(
-        prices_.end() - short_period_, 
-        prices_.end(), 
-        0.0
-    ) / short_period_;
-    
-    double long_ma = std::accumulate(
-        prices_.end() - long_period_, 
-        prices_.end(), 
-        0.0
-    ) / long_period_;
+    // Moving averages from running sums, O(1) per tick
+    double short_ma = state.short_window.mean();
+    double long_ma = state.long_window.mean();
     
     Signal signal;
-    signal.symbol = data.symbol;
+    signal.symbol = data.symbol_id;
     signal.timestamp = data.timestamp;
     
     if (short_ma > long_ma) {
@@ -53,8 +49,8 @@ std::vector<Strategy::Signal> MovingAverageStrategy::onMarketData(
 }
 
 void MovingAverageStrategy::onOrderUpdate(const Order& order) {
-    spdlog::info("Order {} updated: status = {}", 
-                 order.getOrderId(), 
+    spdlog::debug("Order {} updated: status = {}", 
+                 formatOrderId(order.getOrderId()), 
                  static_cast<int>(order.getStatus()));
 }
 
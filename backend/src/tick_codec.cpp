@@ -0,0 +1,435 @@
+#include "tick_codec.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace trading {
+namespace tick_codec {
+
+namespace {
+    enum class Mode : uint8_t { FRAME, DELTA, DELTA2, XOR };
+
+    struct ColumnHeader {
+        uint8_t encoding;
+        uint8_t decimals;
+        uint16_t reserved;
+        uint32_t block_count;
+    };
+
+    struct BlockHeader {
+        uint8_t mode;
+        uint8_t width;     // Bits per residual
+        uint8_t shift;     // XOR: trailing zero bits dropped
+        uint8_t reserved;
+        uint32_t divisor;  // Residuals are differences over their GCD
+        int64_t first;     // First value (bit pattern for XOR)
+        int64_t param;     // FRAME: minimum; DELTA2: first delta
+    };
+
+    // Unpacking loads a whole word at the last residual's byte and one
+    // more byte for widths above 56
+    constexpr size_t kTailPadding = 16;
+    constexpr int kMaxDecimals = 9;
+    // Scaled decimals stay below this so decoding can convert them with
+    // the 2^52 + 2^51 bias trick, which vectorizes where int64 to double
+    // conversion does not
+    constexpr double kMaxScaled = 0x1p51;
+
+    unsigned bitWidth(uint64_t value) {
+        return value == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(value));
+    }
+
+    uint64_t zigzag(uint64_t delta) {
+        return (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+    }
+
+    uint64_t unzigzag(uint64_t value) {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+
+    template <typename T>
+    void append(std::vector<uint8_t>& out, const T& value) {
+        size_t offset = out.size();
+        out.resize(offset + sizeof(T));
+        std::memcpy(out.data() + offset, &value, sizeof(T));
+    }
+
+    // Little-endian, least significant bits first
+    void pack(const uint64_t* values, size_t count, unsigned width, std::vector<uint8_t>& out) {
+        if (width == 0) {
+            return;
+        }
+        uint64_t buffer = 0;
+        unsigned used = 0;
+        for (size_t i = 0; i < count; ++i) {
+            buffer |= values[i] << used;
+            used += width;
+            if (used >= 64) {
+                append(out, buffer);
+                used -= 64;
+                buffer = used == 0 ? 0 : values[i] >> (width - used);
+            }
+        }
+        for (unsigned bits = 0; bits < used; bits += 8) {
+            out.push_back(static_cast<uint8_t>(buffer >> bits));
+        }
+    }
+
+    // Width is a template parameter so the shifts and masks are constants
+    template <unsigned W>
+    void unpack(const uint8_t* in, size_t count, uint64_t* out) {
+        if constexpr (W == 0) {
+            std::fill(out, out + count, 0);
+        } else if constexpr (W <= 56) {
+            // Eight residuals span exactly W bytes, so within a group
+            // every load offset and shift is a constant
+            constexpr uint64_t kMask = (uint64_t{1} << W) - 1;
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8, in += W) {
+#pragma GCC unroll 8
+                for (unsigned j = 0; j < 8; ++j) {
+                    uint64_t word;
+                    std::memcpy(&word, in + (j * W >> 3), sizeof(word));
+                    out[i + j] = (word >> (j * W & 7)) & kMask;
+                }
+            }
+            for (unsigned j = 0; i < count; ++i, ++j) {
+                uint64_t word;
+                std::memcpy(&word, in + (j * W >> 3), sizeof(word));
+                out[i] = (word >> (j * W & 7)) & kMask;
+            }
+        } else {
+            constexpr uint64_t kMask = W == 64 ? ~uint64_t{0} : (uint64_t{1} << W) - 1;
+            for (size_t i = 0; i < count; ++i) {
+                size_t bit = i * W;
+                unsigned offset = bit & 7;
+                uint64_t word;
+                std::memcpy(&word, in + (bit >> 3), sizeof(word));
+                uint64_t value = word >> offset;
+                if (offset + W > 64) {
+                    value |= static_cast<uint64_t>(in[(bit >> 3) + 8]) << (64 - offset);
+                }
+                out[i] = value & kMask;
+            }
+        }
+    }
+
+    using Unpacker = void (*)(const uint8_t*, size_t, uint64_t*);
+
+    template <size_t... W>
+    constexpr std::array<Unpacker, sizeof...(W)> makeUnpackers(std::index_sequence<W...>) {
+        return {&unpack<W>...};
+    }
+
+    constexpr auto kUnpackers = makeUnpackers(std::make_index_sequence<65>());
+
+    // Divides residuals by their GCD, then zigzags the signed ones.
+    // Returns the OR of the results, whose bit width is the packing width.
+    uint64_t divideResiduals(uint64_t* residuals, size_t count, bool is_signed, uint32_t& divisor) {
+        auto negative = [&](uint64_t value) { return is_signed && static_cast<int64_t>(value) < 0; };
+        uint64_t gcd = 0;
+        for (size_t i = 0; i < count && gcd != 1; ++i) {
+            gcd = std::gcd(gcd, negative(residuals[i]) ? 0 - residuals[i] : residuals[i]);
+        }
+        divisor = (gcd == 0 || gcd > std::numeric_limits<uint32_t>::max()) ? 1 : static_cast<uint32_t>(gcd);
+        uint64_t bits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t value = residuals[i];
+            if (divisor != 1) {
+                value = negative(value) ? 0 - (0 - value) / divisor : value / divisor;
+            }
+            residuals[i] = is_signed ? zigzag(value) : value;
+            bits |= residuals[i];
+        }
+        return bits;
+    }
+
+    // Picks the narrowest transform for one block of integers
+    void encodeIntegerBlock(const int64_t* values, size_t count, std::vector<uint8_t>& out) {
+        std::array<uint64_t, kBlockSize> frame, delta, delta2;
+        int64_t min = *std::min_element(values, values + count);
+        for (size_t i = 0; i < count; ++i) {
+            frame[i] = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(min);
+            if (i >= 1) {
+                delta[i - 1] = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]);
+                if (i >= 2) {
+                    delta2[i - 2] = delta[i - 1] - delta[i - 2];
+                }
+            }
+        }
+
+        BlockHeader header{};
+        header.first = values[0];
+        header.mode = static_cast<uint8_t>(Mode::FRAME);
+        header.width = static_cast<uint8_t>(bitWidth(divideResiduals(frame.data(), count, false, header.divisor)));
+        header.param = min;
+        const uint64_t* residuals = frame.data();
+        size_t residual_count = count;
+        if (count >= 2) {
+            uint32_t divisor;
+            unsigned width = bitWidth(divideResiduals(delta.data(), count - 1, true, divisor));
+            if (width * (count - 1) < header.width * residual_count) {
+                residuals = delta.data();
+                residual_count = count - 1;
+                header.mode = static_cast<uint8_t>(Mode::DELTA);
+                header.width = static_cast<uint8_t>(width);
+                header.divisor = divisor;
+                header.param = 0;
+            }
+        }
+        if (count >= 3) {
+            uint32_t divisor;
+            unsigned width = bitWidth(divideResiduals(delta2.data(), count - 2, true, divisor));
+            if (width * (count - 2) < header.width * residual_count) {
+                residuals = delta2.data();
+                residual_count = count - 2;
+                header.mode = static_cast<uint8_t>(Mode::DELTA2);
+                header.width = static_cast<uint8_t>(width);
+                header.divisor = divisor;
+                header.param = static_cast<int64_t>(static_cast<uint64_t>(values[1]) - static_cast<uint64_t>(values[0]));
+            }
+        }
+        append(out, header);
+        pack(residuals, residual_count, header.width, out);
+    }
+
+    void encodeXorBlock(const double* values, size_t count, std::vector<uint8_t>& out) {
+        std::array<uint64_t, kBlockSize> residuals;
+        uint64_t previous;
+        std::memcpy(&previous, &values[0], sizeof(previous));
+        uint64_t any = 0;
+        for (size_t i = 1; i < count; ++i) {
+            uint64_t bits;
+            std::memcpy(&bits, &values[i], sizeof(bits));
+            residuals[i - 1] = bits ^ previous;
+            any |= residuals[i - 1];
+            previous = bits;
+        }
+        unsigned shift = any == 0 ? 0 : static_cast<unsigned>(__builtin_ctzll(any));
+        uint64_t width_bits = 0;
+        for (size_t i = 0; i + 1 < count; ++i) {
+            residuals[i] >>= shift;
+            width_bits |= residuals[i];
+        }
+
+        BlockHeader header{};
+        header.mode = static_cast<uint8_t>(Mode::XOR);
+        header.width = static_cast<uint8_t>(bitWidth(width_bits));
+        header.shift = static_cast<uint8_t>(shift);
+        header.divisor = 1;
+        std::memcpy(&header.first, &values[0], sizeof(header.first));
+        append(out, header);
+        pack(residuals.data(), count - 1, header.width, out);
+    }
+
+    // Fewest decimals at which every value round-trips exactly, or -1
+    int decimalPlaces(Span<const double> values) {
+        double scale = 1.0;
+        for (int decimals = 0; decimals <= kMaxDecimals; ++decimals, scale *= 10.0) {
+            bool exact = true;
+            for (double value : values) {
+                double scaled = std::nearbyint(value * scale);
+                // -0.0 has no integer form
+                if (!(std::fabs(scaled) < kMaxScaled) || scaled / scale != value ||
+                    (value == 0.0 && std::signbit(value))) {
+                    exact = false;
+                    break;
+                }
+            }
+            if (exact) {
+                return decimals;
+            }
+        }
+        return -1;
+    }
+
+    // Header and block offset table; blocks are appended after it
+    size_t beginColumn(Encoding encoding, int decimals, size_t count, std::vector<uint8_t>& out) {
+        ColumnHeader header{};
+        header.encoding = static_cast<uint8_t>(encoding);
+        header.decimals = static_cast<uint8_t>(std::max(decimals, 0));
+        header.block_count = static_cast<uint32_t>((count + kBlockSize - 1) / kBlockSize);
+        size_t start = out.size();
+        append(out, header);
+        out.resize(out.size() + header.block_count * sizeof(uint32_t));
+        return start;
+    }
+
+    void setBlockOffset(size_t start, size_t block, std::vector<uint8_t>& out) {
+        uint64_t offset = out.size() - start;
+        if (offset > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Encoded column exceeds 4 GiB");
+        }
+        uint32_t value = static_cast<uint32_t>(offset);
+        std::memcpy(out.data() + start + sizeof(ColumnHeader) + block * sizeof(uint32_t), &value, sizeof(value));
+    }
+
+    void endColumn(std::vector<uint8_t>& out) {
+        out.resize(out.size() + kTailPadding, 0);
+    }
+}
+
+void encodeIntegers(Span<const int64_t> values, std::vector<uint8_t>& out) {
+    size_t start = beginColumn(Encoding::INTEGER, 0, values.size(), out);
+    for (size_t offset = 0, block = 0; offset < values.size(); offset += kBlockSize, ++block) {
+        setBlockOffset(start, block, out);
+        encodeIntegerBlock(values.data() + offset, std::min(kBlockSize, values.size() - offset), out);
+    }
+    endColumn(out);
+}
+
+void encodeDoubles(Span<const double> values, std::vector<uint8_t>& out) {
+    int decimals = decimalPlaces(values);
+    size_t start = beginColumn(decimals < 0 ? Encoding::XOR : Encoding::DECIMAL, decimals, values.size(), out);
+    double scale = std::pow(10.0, std::max(decimals, 0));
+    std::array<int64_t, kBlockSize> scaled;
+    for (size_t offset = 0, block = 0; offset < values.size(); offset += kBlockSize, ++block) {
+        setBlockOffset(start, block, out);
+        size_t count = std::min(kBlockSize, values.size() - offset);
+        if (decimals < 0) {
+            encodeXorBlock(values.data() + offset, count, out);
+            continue;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            scaled[i] = static_cast<int64_t>(std::nearbyint(values[offset + i] * scale));
+        }
+        encodeIntegerBlock(scaled.data(), count, out);
+    }
+    endColumn(out);
+}
+
+ColumnDecoder::ColumnDecoder(Span<const uint8_t> column, size_t count) : column_(column), count_(count) {
+    ColumnHeader header;
+    if (column.size() < sizeof(header) + kTailPadding) {
+        throw std::runtime_error("Encoded column truncated");
+    }
+    std::memcpy(&header, column.data(), sizeof(header));
+    block_count_ = header.block_count;
+    encoding_ = static_cast<Encoding>(header.encoding);
+    if (header.encoding > static_cast<uint8_t>(Encoding::XOR) || header.decimals > kMaxDecimals ||
+        block_count_ != (count + kBlockSize - 1) / kBlockSize ||
+        sizeof(header) + block_count_ * sizeof(uint32_t) + kTailPadding > column.size()) {
+        throw std::runtime_error("Corrupt encoded column header");
+    }
+    scale_ = std::pow(10.0, header.decimals);
+}
+
+const uint8_t* ColumnDecoder::block(size_t index) const {
+    uint32_t offset;
+    std::memcpy(&offset, column_.data() + sizeof(ColumnHeader) + index * sizeof(uint32_t), sizeof(offset));
+    if (offset + sizeof(BlockHeader) + kTailPadding > column_.size()) {
+        throw std::runtime_error("Corrupt encoded column block offset");
+    }
+    return column_.data() + offset;
+}
+
+int64_t ColumnDecoder::firstInteger(size_t block_index) const {
+    BlockHeader header;
+    std::memcpy(&header, block(block_index), sizeof(header));
+    return header.first;
+}
+
+// Writes the block's values as raw 64-bit patterns; returns the count
+size_t ColumnDecoder::decodeBlock(size_t index, uint64_t* out) const {
+    const uint8_t* data = block(index);
+    BlockHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    size_t count = std::min(kBlockSize, count_ - index * kBlockSize);
+    if (header.width > 64 || header.divisor == 0) {
+        throw std::runtime_error("Corrupt encoded column block");
+    }
+    auto mode = static_cast<Mode>(header.mode);
+    size_t residuals = mode == Mode::FRAME ? count : mode == Mode::DELTA2 ? count - 2 : count - 1;
+    const uint8_t* packed = data + sizeof(header);
+    if ((mode == Mode::DELTA2 && count < 3) ||
+        static_cast<size_t>(packed - column_.data()) + (residuals * header.width + 7) / 8 + kTailPadding >
+            column_.size()) {
+        throw std::runtime_error("Corrupt encoded column block");
+    }
+
+    // Unsigned arithmetic wraps exactly as the encoder's differences did
+    auto first = static_cast<uint64_t>(header.first);
+    uint64_t divisor = header.divisor;
+    switch (mode) {
+        case Mode::FRAME: {
+            kUnpackers[header.width](packed, residuals, out);
+            auto min = static_cast<uint64_t>(header.param);
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = min + out[i] * divisor;
+            }
+            break;
+        }
+        case Mode::DELTA:
+            kUnpackers[header.width](packed, residuals, out + 1);
+            out[0] = first;
+            for (size_t i = 1; i < count; ++i) {
+                out[i] = out[i - 1] + unzigzag(out[i]) * divisor;
+            }
+            break;
+        case Mode::DELTA2: {
+            kUnpackers[header.width](packed, residuals, out + 2);
+            auto delta = static_cast<uint64_t>(header.param);
+            out[0] = first;
+            out[1] = first + delta;
+            for (size_t i = 2; i < count; ++i) {
+                delta += unzigzag(out[i]) * divisor;
+                out[i] = out[i - 1] + delta;
+            }
+            break;
+        }
+        case Mode::XOR:
+            kUnpackers[header.width](packed, residuals, out + 1);
+            out[0] = first;
+            for (size_t i = 1; i < count; ++i) {
+                out[i] = out[i - 1] ^ (out[i] << header.shift);
+            }
+            break;
+        default:
+            throw std::runtime_error("Corrupt encoded column block mode");
+    }
+    return count;
+}
+
+void ColumnDecoder::decode(size_t first, size_t last, int64_t* out) const {
+    if (encoding_ != Encoding::INTEGER) {
+        throw std::logic_error("Decoding a double column as integers");
+    }
+    static_assert(sizeof(int64_t) == sizeof(uint64_t), "Decoded in place");
+    for (size_t index = first; index < last; ++index) {
+        out += decodeBlock(index, reinterpret_cast<uint64_t*>(out));
+    }
+}
+
+void ColumnDecoder::decode(size_t first, size_t last, double* out) const {
+    if (encoding_ == Encoding::INTEGER) {
+        throw std::logic_error("Decoding an integer column as doubles");
+    }
+    std::array<uint64_t, kBlockSize> raw{};
+    std::array<double, kBlockSize> scaled;
+    for (size_t index = first; index < last; ++index) {
+        size_t count = decodeBlock(index, raw.data());
+        if (encoding_ == Encoding::XOR) {
+            std::memcpy(out, raw.data(), count * sizeof(double));
+        } else {
+            // A whole block at a fixed trip count so the loop vectorizes.
+            // Division, not multiplication by 10^-decimals, which is
+            // inexact; it matches the encoder's round-trip check.
+            for (size_t i = 0; i < kBlockSize; ++i) {
+                uint64_t bits = raw[i] + 0x4338000000000000ull;  // Bits of 2^52 + 2^51 + value
+                double biased;
+                std::memcpy(&biased, &bits, sizeof(biased));
+                scaled[i] = (biased - 0x1.8p52) / scale_;
+            }
+            std::memcpy(out, scaled.data(), count * sizeof(double));
+        }
+        out += count;
+    }
+}
+
+} // namespace tick_codec
+} // namespace trading
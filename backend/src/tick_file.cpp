@@ -0,0 +1,60 @@
+#include "tick_file.hpp"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace trading {
+
+namespace {
+    static_assert(std::is_trivially_copyable<MarketData>::value, "MarketData is written as raw bytes");
+
+    constexpr char kMagic[8] = {'T', 'R', 'D', 'T', 'I', 'C', 'K', '1'};
+
+    // Padded to a cache line so the records after it stay aligned
+    struct alignas(64) TickFileHeader {
+        char magic[8];
+        uint32_t record_size;
+        uint32_t reserved;
+        uint64_t count;
+    };
+
+    struct FileCloser {
+        void operator()(FILE* file) const { std::fclose(file); }
+    };
+}
+
+void TickFile::write(const std::string& path, Span<const MarketData> ticks) {
+    std::unique_ptr<FILE, FileCloser> file(std::fopen(path.c_str(), "wb"));
+    if (!file) {
+        throw std::runtime_error("Cannot create tick file " + path);
+    }
+    TickFileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.record_size = sizeof(MarketData);
+    header.count = ticks.size();
+    bool ok = std::fwrite(&header, sizeof(header), 1, file.get()) == 1 &&
+              (ticks.empty() || std::fwrite(ticks.data(), sizeof(MarketData), ticks.size(), file.get()) == ticks.size());
+    if (!ok || std::fflush(file.get()) != 0) {
+        throw std::runtime_error("Failed writing tick file " + path);
+    }
+}
+
+TickFile::TickFile(const std::string& path) : file_(path) {
+    if (file_.size() < sizeof(TickFileHeader)) {
+        throw std::runtime_error(path + " is not a tick file");
+    }
+    TickFileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.record_size != sizeof(MarketData)) {
+        throw std::runtime_error(path + " is not a tick file for this build");
+    }
+    if (header.count > (file_.size() - sizeof(header)) / sizeof(MarketData)) {
+        throw std::runtime_error(path + " is truncated");
+    }
+    ticks_ = file_.view<MarketData>(sizeof(header), header.count);
+    file_.advise(MappedFile::Advice::SEQUENTIAL);
+}
+
+} // namespace trading
@@ -0,0 +1,413 @@
+#include "tick_store.hpp"
+#include "tick_codec.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace trading {
+
+using namespace tick_store;
+
+namespace {
+    constexpr char kMagic[8] = {'T', 'R', 'D', 'S', 'T', 'O', 'R', '1'};
+    constexpr uint32_t kVersion = 2;
+    constexpr size_t kColumnAlignment = 64;  // Raw columns
+    constexpr size_t kPackedAlignment = 8;
+    constexpr int64_t kNanosPerDay = 86400LL * 1000000000LL;
+
+    struct alignas(64) StoreHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    struct SymbolEntry {
+        uint64_t chunk_begin;
+        uint64_t chunk_end;
+        uint64_t name_offset;  // Into the name block
+        uint32_t name_length;
+        uint32_t reserved;
+    };
+
+    // Last bytes of the file
+    struct StoreTrailer {
+        uint64_t chunks_offset;
+        uint64_t chunk_count;
+        uint64_t symbols_offset;
+        uint64_t symbol_count;
+        uint64_t names_offset;
+        uint64_t names_bytes;
+        uint32_t version;
+        uint32_t reserved;
+        char magic[8];
+    };
+
+    int32_t dayOf(int64_t nanos) {
+        int64_t day = nanos / kNanosPerDay;
+        return static_cast<int32_t>(nanos % kNanosPerDay < 0 ? day - 1 : day);
+    }
+
+    // Open range ends map to the extremes rather than overflowing
+    int64_t boundNanos(Timestamp timestamp) {
+        if (timestamp == Timestamp::min()) {
+            return std::numeric_limits<int64_t>::min();
+        }
+        if (timestamp == Timestamp::max()) {
+            return std::numeric_limits<int64_t>::max();
+        }
+        return toEpochNanos(timestamp);
+    }
+}
+
+TickStoreWriter::TickStoreWriter(const std::string& path, Compression compression)
+    : path_(path), compression_(compression), file_(std::fopen(path.c_str(), "wb")) {
+    if (!file_) {
+        throw std::runtime_error("Cannot create tick store " + path);
+    }
+    StoreHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    writeBytes(&header, sizeof(header));
+}
+
+TickStoreWriter::~TickStoreWriter() {
+    if (!file_) {
+        return;
+    }
+    try {
+        finish();
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to finish tick store {}: {}", path_, e.what());
+    }
+}
+
+void TickStoreWriter::append(Span<const MarketData> ticks, Layout layout) {
+    if (!file_) {
+        throw std::logic_error("Tick store " + path_ + " is already finished");
+    }
+    if (ticks.empty()) {
+        return;
+    }
+    SymbolId symbol_id = ticks[0].symbol_id;
+    auto found = symbol_index_.find(symbol_id);
+    int64_t last_ns = found == symbol_index_.end() ? std::numeric_limits<int64_t>::min() : last_ns_[found->second];
+    for (const auto& tick : ticks) {
+        if (tick.symbol_id != symbol_id) {
+            throw std::invalid_argument("Tick store append mixes symbols");
+        }
+        int64_t nanos = toEpochNanos(tick.timestamp);
+        if (nanos < last_ns) {
+            throw std::invalid_argument("Tick store append out of time order for " + symbolName(symbol_id));
+        }
+        last_ns = nanos;
+    }
+
+    uint32_t symbol;
+    if (found == symbol_index_.end()) {
+        symbol = static_cast<uint32_t>(symbols_.size());
+        symbols_.push_back(symbol_id);
+        last_ns_.push_back(last_ns);
+        symbol_index_.emplace(symbol_id, symbol);
+    } else {
+        symbol = found->second;
+        last_ns_[symbol] = last_ns;
+    }
+
+    // One chunk per UTC day
+    size_t begin = 0;
+    while (begin < ticks.size()) {
+        int32_t day = dayOf(toEpochNanos(ticks[begin].timestamp));
+        size_t end = begin + 1;
+        while (end < ticks.size() && dayOf(toEpochNanos(ticks[end].timestamp)) == day) {
+            ++end;
+        }
+        writeChunk(symbol, day, ticks.subspan(begin, end - begin), layout);
+        begin = end;
+    }
+}
+
+void TickStoreWriter::writeChunk(uint32_t symbol, int32_t day, Span<const MarketData> ticks, Layout layout) {
+    ChunkEntry entry{};
+    entry.symbol = symbol;
+    entry.day = day;
+    entry.count = ticks.size();
+
+    timestamps_.clear();
+    for (const auto& tick : ticks) {
+        timestamps_.push_back(toEpochNanos(tick.timestamp));
+    }
+    entry.first_ns = timestamps_.front();
+    entry.last_ns = timestamps_.back();
+    writeColumn(entry, Column::TIMESTAMP, timestamps_);
+
+    auto column = [&](Column id, double MarketData::*field) {
+        values_.clear();
+        for (const auto& tick : ticks) {
+            values_.push_back(tick.*field);
+        }
+        writeColumn(entry, id, values_);
+    };
+    column(Column::PRICE, &MarketData::last_price);
+    if (layout == Layout::BARS) {
+        column(Column::OPEN, &MarketData::open);
+        column(Column::HIGH, &MarketData::high);
+        column(Column::LOW, &MarketData::low);
+    }
+    column(Column::VOLUME, &MarketData::volume);
+    chunks_.push_back(entry);
+}
+
+template <typename T>
+void TickStoreWriter::writeColumn(ChunkEntry& entry, Column column, const std::vector<T>& values) {
+    ColumnRef& ref = entry.columns[static_cast<size_t>(column)];
+    if (compression_ == Compression::NONE) {
+        alignTo(kColumnAlignment);
+        ref = {offset_, values.size() * sizeof(T)};
+        entry.encodings[static_cast<size_t>(column)] = Encoding::RAW;
+        writeBytes(values.data(), ref.bytes);
+        return;
+    }
+    encoded_.clear();
+    if constexpr (std::is_same<T, int64_t>::value) {
+        tick_codec::encodeIntegers(values, encoded_);
+    } else {
+        tick_codec::encodeDoubles(values, encoded_);
+    }
+    alignTo(kPackedAlignment);
+    ref = {offset_, encoded_.size()};
+    entry.encodings[static_cast<size_t>(column)] = Encoding::PACKED;
+    writeBytes(encoded_.data(), encoded_.size());
+}
+
+void TickStoreWriter::writeBytes(const void* data, size_t bytes) {
+    if (bytes > 0 && std::fwrite(data, 1, bytes, file_.get()) != bytes) {
+        throw std::runtime_error("Failed writing tick store " + path_);
+    }
+    offset_ += bytes;
+}
+
+void TickStoreWriter::alignTo(size_t alignment) {
+    static const char kZeros[kColumnAlignment] = {};
+    size_t padding = (alignment - offset_ % alignment) % alignment;
+    writeBytes(kZeros, padding);
+}
+
+void TickStoreWriter::finish() {
+    if (!file_) {
+        return;
+    }
+    // Index sorted by symbol, then time; appends per symbol are in time
+    // order already, so a stable sort keeps them
+    std::stable_sort(chunks_.begin(), chunks_.end(),
+                     [](const ChunkEntry& a, const ChunkEntry& b) { return a.symbol < b.symbol; });
+
+    std::vector<SymbolEntry> symbols(symbols_.size());
+    std::string names;
+    size_t chunk = 0;
+    for (uint32_t i = 0; i < symbols_.size(); ++i) {
+        const std::string& name = symbolName(symbols_[i]);
+        symbols[i].name_offset = names.size();
+        symbols[i].name_length = static_cast<uint32_t>(name.size());
+        names += name;
+        symbols[i].chunk_begin = chunk;
+        while (chunk < chunks_.size() && chunks_[chunk].symbol == i) {
+            ++chunk;
+        }
+        symbols[i].chunk_end = chunk;
+    }
+
+    StoreTrailer trailer{};
+    alignTo(kColumnAlignment);
+    trailer.chunks_offset = offset_;
+    trailer.chunk_count = chunks_.size();
+    writeBytes(chunks_.data(), chunks_.size() * sizeof(ChunkEntry));
+    trailer.symbols_offset = offset_;
+    trailer.symbol_count = symbols.size();
+    writeBytes(symbols.data(), symbols.size() * sizeof(SymbolEntry));
+    trailer.names_offset = offset_;
+    trailer.names_bytes = names.size();
+    writeBytes(names.data(), names.size());
+    alignTo(alignof(StoreTrailer));
+    trailer.version = kVersion;
+    std::memcpy(trailer.magic, kMagic, sizeof(kMagic));
+    writeBytes(&trailer, sizeof(trailer));
+
+    int flushed = std::fflush(file_.get());
+    file_.reset();
+    if (flushed != 0) {
+        throw std::runtime_error("Failed writing tick store " + path_);
+    }
+    spdlog::debug("Tick store {}: {} chunks, {} symbols, {} bytes", path_, chunks_.size(), symbols_.size(), offset_);
+}
+
+TickStore::TickStore(const std::string& path) : file_(path) {
+    if (file_.size() < sizeof(StoreHeader) + sizeof(StoreTrailer) ||
+        std::memcmp(file_.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error(path + " is not a tick store");
+    }
+    StoreTrailer trailer;
+    std::memcpy(&trailer, file_.data() + file_.size() - sizeof(trailer), sizeof(trailer));
+    if (std::memcmp(trailer.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error(path + " is not a finished tick store");
+    }
+    if (trailer.version != kVersion) {
+        throw std::runtime_error(path + " has unsupported tick store version " + std::to_string(trailer.version));
+    }
+
+    try {
+        entries_ = file_.view<ChunkEntry>(trailer.chunks_offset, trailer.chunk_count);
+        Span<const SymbolEntry> symbols = file_.view<SymbolEntry>(trailer.symbols_offset, trailer.symbol_count);
+        Span<const char> names = file_.view<char>(trailer.names_offset, trailer.names_bytes);
+        symbols_.reserve(symbols.size());
+        for (const auto& entry : symbols) {
+            if (entry.name_offset + entry.name_length > names.size() || entry.chunk_begin > entry.chunk_end ||
+                entry.chunk_end > entries_.size()) {
+                throw std::runtime_error(path + " has a corrupt symbol table");
+            }
+            SymbolId id = internSymbol(std::string(names.data() + entry.name_offset, entry.name_length));
+            symbols_.push_back(id);
+            symbol_index_[id] = {entry.chunk_begin, entry.chunk_end};
+        }
+    } catch (const std::out_of_range&) {
+        throw std::runtime_error(path + " has a corrupt footer");
+    }
+    // Lookups jump around the index; the columns are read front to back
+    file_.advise(MappedFile::Advice::RANDOM, trailer.chunks_offset);
+}
+
+size_t TickStore::tickCount(SymbolId symbol) const {
+    auto found = symbol_index_.find(symbol);
+    if (found == symbol_index_.end()) {
+        return 0;
+    }
+    size_t count = 0;
+    for (size_t i = found->second.begin; i < found->second.end; ++i) {
+        count += entries_[i].count;
+    }
+    return count;
+}
+
+Span<const ChunkEntry> TickStore::find(SymbolId symbol, Timestamp start, Timestamp end) const {
+    auto found = symbol_index_.find(symbol);
+    if (found == symbol_index_.end()) {
+        return {};
+    }
+    int64_t start_ns = boundNanos(start);
+    int64_t end_ns = boundNanos(end);
+    const ChunkEntry* first = entries_.data() + found->second.begin;
+    const ChunkEntry* last = entries_.data() + found->second.end;
+    // Chunks of a symbol are in time order, so both bounds are sorted
+    first = std::lower_bound(first, last, start_ns,
+                             [](const ChunkEntry& e, int64_t nanos) { return e.last_ns < nanos; });
+    last = std::upper_bound(first, last, end_ns,
+                            [](int64_t nanos, const ChunkEntry& e) { return nanos < e.first_ns; });
+    return {first, static_cast<size_t>(last - first)};
+}
+
+TickStore::Chunk TickStore::load(const ChunkEntry& entry, Buffer& buffer, Timestamp start, Timestamp end) const {
+    int64_t start_ns = boundNanos(start);
+    int64_t end_ns = boundNanos(end);
+    auto ref = [&](Column id) -> const ColumnRef& { return entry.columns[static_cast<size_t>(id)]; };
+    auto packed = [&](Column id) { return entry.encodings[static_cast<size_t>(id)] == Encoding::PACKED; };
+    auto bytes = [&](Column id) { return file_.view<uint8_t>(ref(id).offset, ref(id).bytes); };
+
+    // Rows [first_row, first_row + timestamps.size()) may hold the range:
+    // every row, or only the overlapping blocks when timestamps are packed
+    size_t first_block = 0;
+    size_t last_block = (entry.count + tick_codec::kBlockSize - 1) / tick_codec::kBlockSize;
+    Span<const int64_t> timestamps;
+    if (!packed(Column::TIMESTAMP)) {
+        timestamps = file_.view<int64_t>(ref(Column::TIMESTAMP).offset, entry.count);
+    } else {
+        tick_codec::ColumnDecoder decoder(bytes(Column::TIMESTAMP), entry.count);
+        auto blocksBefore = [&](auto inside) {
+            size_t low = 0, high = decoder.blockCount();
+            while (low < high) {
+                size_t middle = (low + high) / 2;
+                if (inside(decoder.firstInteger(middle))) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            return low;
+        };
+        if (entry.first_ns < start_ns) {
+            // The last block starting before start_ns may still reach it
+            first_block = std::max<size_t>(blocksBefore([&](int64_t first) { return first < start_ns; }), 1) - 1;
+        }
+        if (entry.last_ns > end_ns) {
+            last_block = std::max(first_block, blocksBefore([&](int64_t first) { return first <= end_ns; }));
+        }
+        size_t rows = std::min<size_t>(entry.count, last_block * tick_codec::kBlockSize) -
+                      std::min<size_t>(entry.count, first_block * tick_codec::kBlockSize);
+        buffer.timestamps.resize(rows);
+        decoder.decode(first_block, last_block, buffer.timestamps.data());
+        timestamps = buffer.timestamps;
+    }
+    size_t first_row = std::min<size_t>(entry.count, first_block * tick_codec::kBlockSize);
+
+    size_t begin = 0;
+    size_t stop = timestamps.size();
+    if (entry.first_ns < start_ns) {
+        begin = std::lower_bound(timestamps.begin(), timestamps.end(), start_ns) - timestamps.begin();
+    }
+    if (entry.last_ns > end_ns) {
+        stop = std::upper_bound(timestamps.begin(), timestamps.end(), end_ns) - timestamps.begin();
+    }
+    size_t count = stop > begin ? stop - begin : 0;
+
+    Chunk chunk;
+    chunk.symbol = symbols_[entry.symbol];
+    chunk.day = entry.day;
+    chunk.timestamps = timestamps.subspan(begin, count);
+    if (count == 0) {
+        return chunk;
+    }
+    auto column = [&](Column id) -> Span<const double> {
+        if (ref(id).offset == 0) {
+            return {};
+        }
+        if (!packed(id)) {
+            return file_.view<double>(ref(id).offset, entry.count).subspan(first_row + begin, count);
+        }
+        std::vector<double>& values = buffer.values[static_cast<size_t>(id)];
+        values.resize(timestamps.size());
+        tick_codec::ColumnDecoder(bytes(id), entry.count).decode(first_block, last_block, values.data());
+        return Span<const double>(values).subspan(begin, count);
+    };
+    chunk.prices = column(Column::PRICE);
+    chunk.open = column(Column::OPEN);
+    chunk.high = column(Column::HIGH);
+    chunk.low = column(Column::LOW);
+    chunk.volumes = column(Column::VOLUME);
+    return chunk;
+}
+
+size_t TickStore::read(SymbolId symbol, Timestamp start, Timestamp end, std::vector<MarketData>& out) const {
+    size_t before = out.size();
+    Buffer buffer;
+    for (const ChunkEntry& entry : find(symbol, start, end)) {
+        Chunk chunk = load(entry, buffer, start, end);
+        size_t offset = out.size();
+        out.resize(offset + chunk.size());
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            MarketData& tick = out[offset + i];
+            tick.symbol_id = chunk.symbol;
+            tick.timestamp = fromEpochNanos(chunk.timestamps[i]);
+            tick.last_price = chunk.prices[i];
+            tick.volume = chunk.volumes[i];
+            if (chunk.hasBars()) {
+                tick.open = chunk.open[i];
+                tick.high = chunk.high[i];
+                tick.low = chunk.low[i];
+            }
+        }
+    }
+    return out.size() - before;
+}
+
+} // namespace trading
@@ -0,0 +1,243 @@
+#include "var_engine.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace trading {
+
+namespace {
+    constexpr size_t kDoublesPerLine = kCacheLineSize / sizeof(double);
+
+    double dot(const double* a, const double* b, size_t n) {
+        double result = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+}
+
+double inverseNormalCdf(double p) {
+    if (p <= 0.0 || p >= 1.0) {
+        throw std::invalid_argument("inverseNormalCdf requires 0 < p < 1");
+    }
+
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                               -2.759285104469687e+02, 1.383577518672690e+02,
+                               -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                               -1.556989798598866e+02, 6.680131188771972e+01,
+                               -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                               -2.400758277161838e+00, -2.549732539343734e+00,
+                               4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                               2.445134137142996e+00, 3.754408661907416e+00};
+    constexpr double kLow = 0.02425;
+
+    auto tail = [&](double q) {
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    };
+
+    if (p < kLow) {
+        return tail(std::sqrt(-2.0 * std::log(p)));
+    }
+    if (p > 1.0 - kLow) {
+        return -tail(std::sqrt(-2.0 * std::log(1.0 - p)));
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+VarEngine::VarEngine() : VarEngine(Options()) {}
+
+VarEngine::VarEngine(const Options& options)
+    : options_(options),
+      stride_((options.max_assets + kDoublesPerLine - 1) / kDoublesPerLine * kDoublesPerLine),
+      column_of_(SymbolTable::kMaxSymbols, kNoColumn),
+      prices_(stride_, 0.0),
+      sampled_prices_(stride_, 0.0),
+      exposures_(stride_, 0.0),
+      returns_(options.window * stride_, 0.0),
+      sums_(stride_, 0.0),
+      cross_(stride_ * stride_, 0.0),
+      scratch_(std::max(stride_, options.window), 0.0) {
+    if (options.window < 2) {
+        throw std::invalid_argument("VaR window must hold at least two samples");
+    }
+    if (options.max_assets == 0) {
+        throw std::invalid_argument("VaR engine needs at least one asset");
+    }
+    if (options.confidence <= 0.5 || options.confidence >= 1.0) {
+        throw std::invalid_argument("VaR confidence must be in (0.5, 1)");
+    }
+    z_ = inverseNormalCdf(options.confidence);
+    tail_density_ = std::exp(-0.5 * z_ * z_) / std::sqrt(2.0 * M_PI) / (1.0 - options.confidence);
+}
+
+uint32_t VarEngine::columnFor(SymbolId symbol) {
+    if (symbol >= column_of_.size()) {
+        return kNoColumn;
+    }
+    uint32_t& column = column_of_[symbol];
+    if (column != kNoColumn) {
+        return column;
+    }
+    if (assets_ < options_.max_assets) {
+        column = static_cast<uint32_t>(assets_++);
+    } else if (!full_warned_) {
+        spdlog::warn("VaR engine full ({} assets), ignoring {}", assets_, symbolName(symbol));
+        full_warned_ = true;
+    }
+    return column;
+}
+
+bool VarEngine::onPrice(SymbolId symbol, double price) {
+    uint32_t column = columnFor(symbol);
+    if (column == kNoColumn) {
+        return false;
+    }
+    prices_[column] = price;
+    return true;
+}
+
+bool VarEngine::setExposure(SymbolId symbol, double market_value) {
+    uint32_t column = columnFor(symbol);
+    if (column == kNoColumn) {
+        return false;
+    }
+    exposures_[column] = market_value;
+    return true;
+}
+
+void VarEngine::sampleReturns() {
+    const size_t n = assets_;
+    const size_t window = options_.window;
+
+    // The first call only fixes the starting prices
+    if (!primed_) {
+        std::copy(prices_.begin(), prices_.end(), sampled_prices_.begin());
+        primed_ = true;
+        return;
+    }
+
+    // Reuse the oldest row once the window is full, retiring its terms
+    double* slot;
+    if (count_ == window) {
+        slot = row(head_);
+        for (size_t i = 0; i < n; ++i) {
+            sums_[i] -= slot[i];
+            double* cross_row = cross_.data() + i * stride_;
+            for (size_t j = 0; j < n; ++j) {
+                cross_row[j] -= slot[i] * slot[j];
+            }
+        }
+        head_ = (head_ + 1) % window;
+    } else {
+        slot = row((head_ + count_) % window);
+        ++count_;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        double previous = sampled_prices_[i];
+        slot[i] = (previous > 0.0 && prices_[i] > 0.0) ? prices_[i] / previous - 1.0 : 0.0;
+        sampled_prices_[i] = prices_[i];
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        sums_[i] += slot[i];
+        double* cross_row = cross_.data() + i * stride_;
+        for (size_t j = 0; j < n; ++j) {
+            cross_row[j] += slot[i] * slot[j];
+        }
+    }
+
+    // Add/subtract drift is bounded by rebuilding once per full window
+    if (++samples_since_rebuild_ >= window) {
+        rebuildSums();
+    }
+}
+
+bool VarEngine::sampleIfDue(std::chrono::steady_clock::time_point now) {
+    if (now - last_sample_ < options_.sample_interval) {
+        return false;
+    }
+    last_sample_ = now;
+    sampleReturns();
+    return true;
+}
+
+void VarEngine::rebuildSums() {
+    const size_t n = assets_;
+    std::fill(sums_.begin(), sums_.end(), 0.0);
+    std::fill(cross_.begin(), cross_.end(), 0.0);
+    for (size_t t = 0; t < count_; ++t) {
+        const double* r = row(t);
+        for (size_t i = 0; i < n; ++i) {
+            sums_[i] += r[i];
+            double* cross_row = cross_.data() + i * stride_;
+            for (size_t j = 0; j < n; ++j) {
+                cross_row[j] += r[i] * r[j];
+            }
+        }
+    }
+    samples_since_rebuild_ = 0;
+}
+
+void VarEngine::buildModel(MarketModel& model) const {
+    const size_t n = assets_;
+    const size_t m = count_;
+    model.assets = n;
+    model.samples = m;
+    model.exposures.assign(exposures_.begin(), exposures_.begin() + n);
+    model.returns.resize(m * n);
+    for (size_t t = 0; t < m; ++t) {
+        const double* source = row((head_ + t) % options_.window);
+        std::copy(source, source + n, model.returns.data() + t * n);
+    }
+}
+
+VarEstimate VarEngine::evaluate() {
+    VarEstimate estimate;
+    const size_t m = count_;
+    if (m < 2) {
+        return estimate;
+    }
+    const size_t n = assets_;
+    const double* w = exposures_.data();
+
+    // Parametric: sigma^2 = (w' X'X w - m mu^2) / (m - 1), straight from
+    // the running cross-products; no covariance matrix is materialized
+    double mean_pnl = dot(w, sums_.data(), n) / m;
+    double* tmp = scratch_.data();
+    for (size_t i = 0; i < n; ++i) {
+        tmp[i] = dot(cross_.data() + i * stride_, w, n);
+    }
+    double variance = std::max(0.0, (dot(w, tmp, n) - m * mean_pnl * mean_pnl) / (m - 1));
+    double sigma = std::sqrt(variance);
+    estimate.parametric_var = z_ * sigma - mean_pnl;
+    estimate.parametric_cvar = tail_density_ * sigma - mean_pnl;
+
+    // Historical: revalue current exposures on every stored return row
+    double* pnl = scratch_.data();
+    for (size_t t = 0; t < m; ++t) {
+        pnl[t] = dot(row(t), w, n);
+    }
+    size_t tail = static_cast<size_t>(std::ceil((1.0 - options_.confidence) * m - 1e-9));
+    size_t k = tail > 0 ? tail - 1 : 0;
+    std::nth_element(pnl, pnl + k, pnl + m);
+    double tail_sum = 0.0;
+    for (size_t t = 0; t <= k; ++t) {
+        tail_sum += pnl[t];
+    }
+    estimate.historical_var = -pnl[k];
+    estimate.historical_cvar = -tail_sum / (k + 1);
+    estimate.samples = m;
+    return estimate;
+}
+
+} // namespace trading
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "backtest_engine.hpp"
+#include "historical_stream.hpp"
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Buys once at the first tick, sells at the fifth
+class ScriptedStrategy : public trading::Strategy {
+public:
+    void initialize() override {
+        ticks = 0;
+        updates.clear();
+    }
+
+    std::vector<Signal> onMarketData(const trading::MarketData& data) override {
+        ++ticks;
+        if (ticks != 1 && ticks != 5) {
+            return {};
+        }
+        Signal signal;
+        signal.symbol = data.symbol_id;
+        signal.side = ticks == 1 ? trading::OrderSide::BUY : trading::OrderSide::SELL;
+        signal.strength = 1.0;
+        signal.timestamp = data.timestamp;
+        return {signal};
+    }
+
+    void onOrderUpdate(const trading::Order& order) override { updates.push_back(order); }
+
+    int ticks = 0;
+    std::vector<trading::Order> updates;
+};
+
+std::vector<trading::MarketData> makeTicks(const std::vector<double>& prices,
+                                           std::chrono::nanoseconds spacing = std::chrono::hours(24)) {
+    std::vector<trading::MarketData> ticks;
+    trading::SymbolId symbol = trading::internSymbol("BT");
+    for (size_t i = 0; i < prices.size(); ++i) {
+        trading::MarketData tick;
+        tick.symbol_id = symbol;
+        tick.last_price = prices[i];
+        tick.volume = 1000.0;
+        tick.timestamp = trading::Timestamp(spacing * (i + 1));
+        ticks.push_back(tick);
+    }
+    return ticks;
+}
+
+} // namespace
+
+TEST(BacktestEngineTest, RoundTripThroughExecutorAndExchange) {
+    ScriptedStrategy strategy;
+    trading::BacktestEngine::Options options;
+    options.initial_capital = 10000.0;
+    options.position_size_limit = 0.5;
+    options.commission_rate = 0.001;
+    trading::BacktestEngine engine(strategy, options);
+
+    auto ticks = makeTicks({100.0, 101.0, 102.0, 103.0, 110.0, 111.0});
+    trading::BacktestResult result = engine.run(ticks);
+
+    EXPECT_EQ(result.events, 6u);
+    EXPECT_EQ(result.orders_submitted, 2u);
+    ASSERT_EQ(result.trades.size(), 2u);
+    // Zero latency: each market order fills at the price that produced it
+    EXPECT_DOUBLE_EQ(result.trades[0].price, 100.0);
+    EXPECT_DOUBLE_EQ(result.trades[0].quantity, 50.0);
+    EXPECT_EQ(result.trades[1].side, trading::OrderSide::SELL);
+    EXPECT_DOUBLE_EQ(result.trades[1].price, 110.0);
+    EXPECT_GT(result.final_value, options.initial_capital);
+    EXPECT_DOUBLE_EQ(result.commission, 0.001 * (50.0 * 100.0 + result.trades[1].quantity * 110.0));
+    EXPECT_EQ(result.equity_curve.size(), 7u);
+    EXPECT_FALSE(strategy.updates.empty());
+}
+
+TEST(BacktestEngineTest, LatencyDelaysFillsToLaterTicks) {
+    ScriptedStrategy strategy;
+    trading::BacktestEngine::Options options;
+    options.initial_capital = 10000.0;
+    options.position_size_limit = 0.5;
+    options.exchange.latency.order_latency = std::chrono::hours(36);
+    trading::BacktestEngine engine(strategy, options);
+
+    // The buy decided at 100 reaches the exchange after the second tick
+    auto ticks = makeTicks({100.0, 104.0, 105.0, 106.0, 107.0});
+    trading::BacktestResult first = engine.run(ticks);
+    ASSERT_GE(first.trades.size(), 1u);
+    EXPECT_DOUBLE_EQ(first.trades[0].price, 104.0);
+
+    // Runs are repeatable on the same engine
+    trading::BacktestResult second = engine.run(ticks);
+    ASSERT_EQ(second.trades.size(), first.trades.size());
+    EXPECT_DOUBLE_EQ(second.final_value, first.final_value);
+}
+
+TEST(BacktestEngineTest, ExitsALosingPositionWithinTheSession) {
+    ScriptedStrategy strategy;
+    trading::BacktestEngine::Options options;
+    options.initial_capital = 10000.0;
+    options.position_size_limit = 0.5;
+    trading::BacktestEngine engine(strategy, options);
+
+    // Minutes apart, so the loss stays on one session's daily P&L
+    auto ticks = makeTicks({100.0, 99.9, 99.8, 99.8, 99.8, 99.7}, std::chrono::minutes(1));
+    trading::BacktestResult result = engine.run(ticks);
+
+    EXPECT_EQ(result.orders_rejected, 0u);
+    ASSERT_EQ(result.trades.size(), 2u);
+    EXPECT_EQ(result.trades[1].side, trading::OrderSide::SELL);
+    EXPECT_DOUBLE_EQ(result.trades[1].price, 99.8);
+    const trading::Position* position = engine.getPortfolio().getPosition(ticks[0].symbol_id);
+    ASSERT_NE(position, nullptr);
+    // The exit is sized from portfolio value, so it is flat to within a share
+    EXPECT_NEAR(position->getQuantity(), 0.0, 1.0);
+    EXPECT_LT(result.final_value, options.initial_capital);
+}
+
+TEST(BacktestEngineTest, ReplaysHistoricalStreamLikeVector) {
+    ScriptedStrategy strategy;
+    trading::BacktestEngine::Options options;
+    options.initial_capital = 10000.0;
+    options.position_size_limit = 0.5;
+    trading::BacktestEngine engine(strategy, options);
+
+    auto ticks = makeTicks({100.0, 101.0, 102.0, 103.0, 110.0, 111.0, 108.0});
+    std::string path = "/tmp/backtest_stream_" + std::to_string(::getpid()) + ".store";
+    {
+        trading::TickStoreWriter writer(path);
+        writer.append(ticks);
+        writer.finish();
+    }
+    trading::HistoricalStream::Options stream_options;
+    stream_options.batch_size = 2;
+    trading::HistoricalStream stream(path, {ticks[0].symbol_id}, trading::Timestamp::min(),
+                                     trading::Timestamp::max(), stream_options);
+
+    trading::BacktestResult streamed = engine.run(stream);
+    trading::BacktestResult loaded = engine.run(ticks);
+    EXPECT_EQ(streamed.events, loaded.events);
+    ASSERT_EQ(streamed.trades.size(), loaded.trades.size());
+    EXPECT_DOUBLE_EQ(streamed.trades[1].price, loaded.trades[1].price);
+    EXPECT_DOUBLE_EQ(streamed.final_value, loaded.final_value);
+    std::remove(path.c_str());
+}
@@ -12,7 +12,7 @@ protected:
 
 TEST_F(DataLoaderTest, LoadMarketData) {
     auto data = data_loader_->loadMarketData("AAPL");
-    EXPECT_FALSE(data.symbol.empty());
+    EXPECT_EQ(trading::symbolName(data.symbol_id), "AAPL");
     EXPECT_GT(data.last_price, 0);
 }
 
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "event_loop.hpp"
+#include <thread>
+#include <vector>
+
+class EventLoopTest : public ::testing::TestWithParam<bool> {
+protected:
+    trading::EventLoop::Options makeOptions() const {
+        trading::EventLoop::Options options;
+        options.busy_spin = GetParam();
+        options.housekeeping_interval = std::chrono::milliseconds(10);
+        return options;
+    }
+};
+
+TEST_P(EventLoopTest, DeliversPostedMarketData) {
+    trading::EventLoop loop(makeOptions());
+    int received = 0;
+
+    std::thread producer([&loop] {
+        for (int i = 0; i < 100; ++i) {
+            trading::MarketData data;
+            data.last_price = 100.0 + i;
+            loop.post(data);
+        }
+    });
+
+    loop.run(
+        [&](const trading::EngineEvent& event) {
+            EXPECT_EQ(event.type, trading::EngineEvent::Type::MARKET_DATA);
+            if (++received == 100) {
+                loop.stop();
+            }
+        },
+        [] {});
+    producer.join();
+
+    EXPECT_EQ(received, 100);
+}
+
+TEST_P(EventLoopTest, DeliversMixedEvents) {
+    trading::EventLoop loop(makeOptions());
+    std::vector<trading::EngineEvent> received;
+
+    trading::MarketData data;
+    data.symbol_id = trading::internSymbol("LOOP_MIXED");
+    data.last_price = 101.5;
+    loop.post(data);
+
+    trading::OrderUpdate update{trading::Order("LOOP_MIXED", trading::OrderSide::SELL,
+                                               trading::OrderType::LIMIT, 25.0)};
+    update.fill_quantity = 10.0;
+    update.fill_price = 101.25;
+    loop.post(update);
+
+    loop.run(
+        [&](const trading::EngineEvent& event) {
+            received.push_back(event);
+            if (received.size() == 2) {
+                loop.stop();
+            }
+        },
+        [] {});
+
+    ASSERT_EQ(received.size(), 2u);
+    ASSERT_EQ(received[0].type, trading::EngineEvent::Type::MARKET_DATA);
+    EXPECT_EQ(received[0].market_data.symbol_id, data.symbol_id);
+    EXPECT_EQ(received[0].market_data.last_price, 101.5);
+    ASSERT_EQ(received[1].type, trading::EngineEvent::Type::ORDER_UPDATE);
+    EXPECT_EQ(received[1].order_update.order.getOrderId(), update.order.getOrderId());
+    EXPECT_EQ(received[1].order_update.order.getSide(), trading::OrderSide::SELL);
+    EXPECT_EQ(received[1].order_update.fill_quantity, 10.0);
+    EXPECT_EQ(received[1].order_update.fill_price, 101.25);
+}
+
+TEST_P(EventLoopTest, HousekeepingRunsWithoutEvents) {
+    trading::EventLoop loop(makeOptions());
+    int ticks = 0;
+
+    loop.run([](const trading::EngineEvent&) {}, [&] {
+        if (++ticks == 3) {
+            loop.stop();
+        }
+    });
+
+    EXPECT_EQ(ticks, 3);
+}
+
+TEST_P(EventLoopTest, StopBeforeRunIsKept) {
+    trading::EventLoop loop(makeOptions());
+    loop.stop();
+
+    int ticks = 0;
+    loop.run([](const trading::EngineEvent&) {}, [&] { ++ticks; });
+
+    EXPECT_EQ(ticks, 0);
+    EXPECT_FALSE(loop.isRunning());
+}
+
+TEST_P(EventLoopTest, StopWakesAnIdleLoop) {
+    auto options = makeOptions();
+    options.housekeeping_interval = std::chrono::seconds(30);
+    trading::EventLoop loop(options);
+
+    std::thread stopper([&loop] {
+        while (!loop.isRunning()) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loop.stop();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    loop.run([](const trading::EngineEvent&) {}, [] {});
+    stopper.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+INSTANTIATE_TEST_SUITE_P(WaitModes, EventLoopTest, ::testing::Values(false, true));
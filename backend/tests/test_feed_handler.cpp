@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "feed_handler.hpp"
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+class FeedHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        csv_path_ = ::testing::TempDir() + "feed_handler_test.csv";
+        std::ofstream csv(csv_path_);
+        csv << "timestamp_ns,symbol,open,high,low,close,volume\n";
+        csv << "1700000000000000000,AAPL,189.5,190.0,189.0,189.75,1200\n";
+        csv << "1700000001000000000,MSFT,370.0,371.0,369.5,370.5,800\n";
+    }
+
+    void TearDown() override {
+        std::remove(csv_path_.c_str());
+    }
+
+    std::string csv_path_;
+};
+
+TEST_F(FeedHandlerTest, CsvReplayDecodesTicks) {
+    trading::CsvReplaySource source(csv_path_);
+    source.open();
+
+    trading::MarketData tick;
+    ASSERT_TRUE(source.next(tick));
+    EXPECT_EQ(trading::symbolName(tick.symbol_id), "AAPL");
+    EXPECT_DOUBLE_EQ(tick.last_price, 189.75);
+    EXPECT_DOUBLE_EQ(tick.volume, 1200);
+
+    ASSERT_TRUE(source.next(tick));
+    EXPECT_EQ(trading::symbolName(tick.symbol_id), "MSFT");
+    EXPECT_FALSE(source.next(tick));
+}
+
+TEST_F(FeedHandlerTest, BinaryRoundTrip) {
+    std::string path = ::testing::TempDir() + "feed_handler_test.bin";
+    {
+        trading::CsvReplaySource csv(csv_path_);
+        trading::BinaryTickWriter writer(path);
+        csv.open();
+        trading::MarketData tick;
+        while (csv.next(tick)) {
+            writer.write(tick);
+        }
+    }
+
+    trading::BinaryReplaySource source(path, 1);
+    source.open();
+    trading::MarketData tick;
+    ASSERT_TRUE(source.next(tick));
+    EXPECT_EQ(trading::symbolName(tick.symbol_id), "AAPL");
+    EXPECT_DOUBLE_EQ(tick.high, 190.0);
+    ASSERT_TRUE(source.next(tick));
+    EXPECT_DOUBLE_EQ(tick.low, 369.5);
+    EXPECT_FALSE(source.next(tick));
+    std::remove(path.c_str());
+}
+
+TEST_F(FeedHandlerTest, TcpFeedFromReplayServer) {
+    trading::FeedReplayServer server(std::make_unique<trading::CsvReplaySource>(csv_path_), 0);
+    server.start();
+
+    std::vector<trading::MarketData> received;
+    trading::FeedHandler handler(
+        std::make_unique<trading::TcpFeedSource>("127.0.0.1", server.getPort()),
+        [&received](const trading::MarketData& tick) { received.push_back(tick); });
+    handler.start();
+
+    for (int i = 0; i < 200 && handler.isRunning(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    handler.stop();
+    server.stop();
+
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(trading::symbolName(received[1].symbol_id), "MSFT");
+    EXPECT_DOUBLE_EQ(received[1].last_price, 370.5);
+}
+
+TEST_F(FeedHandlerTest, CsvSkipsOverlongLines) {
+    {
+        // Cut at the read buffer this line would parse as a wrong volume
+        std::ofstream csv(csv_path_, std::ios::app);
+        csv << "1700000002000000000,AAPL,189.5,190.0,189.0,189.75," << std::string(600, '9') << "\n";
+        csv << "1700000003000000000,AAPL,189.5,190.0,189.0,189.8,100\n";
+    }
+    trading::CsvReplaySource source(csv_path_);
+    source.open();
+
+    trading::MarketData tick;
+    ASSERT_TRUE(source.next(tick));
+    ASSERT_TRUE(source.next(tick));
+    ASSERT_TRUE(source.next(tick));
+    EXPECT_DOUBLE_EQ(tick.last_price, 189.8);
+    EXPECT_DOUBLE_EQ(tick.volume, 100);
+    EXPECT_FALSE(source.next(tick));
+}
+
+TEST_F(FeedHandlerTest, TcpSkipsOverlongLines) {
+    namespace asio = boost::asio;
+    asio::io_context io;
+    asio::ip::tcp::acceptor acceptor(io, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    uint16_t port = acceptor.local_endpoint().port();
+
+    // A megabyte without a newline between two good lines
+    std::thread peer([&acceptor] {
+        asio::ip::tcp::socket socket = acceptor.accept();
+        asio::write(socket, asio::buffer(std::string("1700000000000000000,AAPL,189.5,190.0,189.0,189.75,1200\n")));
+        asio::write(socket, asio::buffer(std::string(1 << 20, '9')));
+        asio::write(socket, asio::buffer(std::string("\n1700000001000000000,MSFT,370.0,371.0,369.5,370.5,800\n")));
+    });
+
+    trading::TcpFeedSource source("127.0.0.1", port);
+    source.open();
+    trading::MarketData tick;
+    ASSERT_TRUE(source.next(tick));
+    EXPECT_EQ(trading::symbolName(tick.symbol_id), "AAPL");
+    ASSERT_TRUE(source.next(tick));
+    EXPECT_EQ(trading::symbolName(tick.symbol_id), "MSFT");
+    EXPECT_DOUBLE_EQ(tick.volume, 800);
+    EXPECT_FALSE(source.next(tick));
+    peer.join();
+}
+
+TEST_F(FeedHandlerTest, PacedReplayStopsDuringAGap) {
+    {
+        std::ofstream csv(csv_path_, std::ios::app);
+        csv << "1700036000000000000,AAPL,189.5,190.0,189.0,189.8,100\n";  // Ten hours later
+    }
+    std::atomic<int> received{0};
+    trading::FeedHandler handler(std::make_unique<trading::CsvReplaySource>(csv_path_),
+                                 [&received](const trading::MarketData&) { ++received; }, true);
+    handler.start();
+    // The first two ticks are a second apart, then the ten-hour gap starts
+    for (int i = 0; i < 400 && received < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(received.load(), 2);
+
+    auto start = std::chrono::steady_clock::now();
+    handler.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_EQ(received.load(), 2);
+}
+
+TEST_F(FeedHandlerTest, ReplayServerStopsWithBlockedClient) {
+    {
+        // Far more than the socket buffers hold
+        std::ofstream csv(csv_path_, std::ios::app);
+        for (int i = 0; i < 200000; ++i) {
+            csv << 1700000002000000000LL + i << ",AAPL,189.5,190.0,189.0,189.75,1200\n";
+        }
+    }
+    trading::FeedReplayServer server(std::make_unique<trading::CsvReplaySource>(csv_path_), 0);
+    server.start();
+
+    // Connects and never reads, so the server blocks in write
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::socket client(io);
+    client.open(boost::asio::ip::tcp::v4());
+    client.set_option(boost::asio::socket_base::receive_buffer_size(4096));
+    client.connect({boost::asio::ip::address_v4::loopback(), server.getPort()});
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto start = std::chrono::steady_clock::now();
+    server.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
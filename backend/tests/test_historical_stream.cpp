@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "historical_stream.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+constexpr int64_t kNanosPerDay = 86400LL * 1000000000LL;
+constexpr int64_t kNanosPerSecond = 1000000000LL;
+constexpr int64_t kDay = 19000;
+
+std::string tempPath(const char* name) {
+    return "/tmp/" + std::string(name) + "_" + std::to_string(::getpid()) + ".store";
+}
+
+// Two days of ticks every spacing seconds; symbols with spacings that
+// share multiples tick at the same time
+std::vector<trading::MarketData> makeTicks(const std::string& symbol, int64_t spacing, double base) {
+    std::vector<trading::MarketData> ticks;
+    trading::SymbolId id = trading::internSymbol(symbol);
+    for (int64_t d = kDay; d < kDay + 2; ++d) {
+        for (int64_t second = 0; second < 3600; second += spacing) {
+            trading::MarketData tick;
+            tick.symbol_id = id;
+            tick.timestamp = trading::fromEpochNanos(d * kNanosPerDay + (34200 + second) * kNanosPerSecond);
+            tick.last_price = base + static_cast<double>(ticks.size() % 100) * 0.01;
+            tick.volume = 100.0 * static_cast<double>(1 + ticks.size() % 7);
+            ticks.push_back(tick);
+        }
+    }
+    return ticks;
+}
+
+// Every batch of stream, checking none is larger than batch_size
+std::vector<trading::MarketData> drain(trading::HistoricalStream& stream, size_t batch_size) {
+    std::vector<trading::MarketData> ticks;
+    for (auto batch = stream.next(); !batch.empty(); batch = stream.next()) {
+        EXPECT_LE(batch.size(), batch_size);
+        ticks.insert(ticks.end(), batch.begin(), batch.end());
+    }
+    EXPECT_TRUE(stream.next().empty());
+    return ticks;
+}
+
+class HistoricalStreamTest : public ::testing::TestWithParam<trading::TickStoreWriter::Compression> {
+protected:
+    void SetUp() override {
+        path_ = tempPath("historical_stream");
+        series_ = {makeTicks("STREAM_A", 2, 100.0), makeTicks("STREAM_B", 3, 50.0), makeTicks("STREAM_C", 7, 20.0)};
+        trading::TickStoreWriter writer(path_, GetParam());
+        for (const auto& ticks : series_) {
+            writer.append(ticks);
+        }
+        writer.finish();
+    }
+
+    void TearDown() override { std::remove(path_.c_str()); }
+
+    // Ticks of symbols in [start, end] ordered by time, ties in symbols order
+    std::vector<trading::MarketData> expected(const std::vector<size_t>& symbols, trading::Timestamp start,
+                                              trading::Timestamp end) const {
+        std::vector<trading::MarketData> ticks;
+        for (size_t s : symbols) {
+            for (const auto& tick : series_[s]) {
+                if (tick.timestamp >= start && tick.timestamp <= end) {
+                    ticks.push_back(tick);
+                }
+            }
+        }
+        std::stable_sort(ticks.begin(), ticks.end(), [](const auto& a, const auto& b) {
+            return a.timestamp < b.timestamp;
+        });
+        return ticks;
+    }
+
+    std::vector<trading::SymbolId> ids(const std::vector<size_t>& symbols) const {
+        std::vector<trading::SymbolId> result;
+        for (size_t s : symbols) {
+            result.push_back(series_[s][0].symbol_id);
+        }
+        return result;
+    }
+
+    std::string path_;
+    std::vector<std::vector<trading::MarketData>> series_;
+};
+
+} // namespace
+
+TEST_P(HistoricalStreamTest, MergesSymbolsInTimeOrder) {
+    trading::HistoricalStream::Options options;
+    options.batch_size = 100;
+    options.prefetch = 1;
+    for (const std::vector<size_t>& symbols : {std::vector<size_t>{0, 1, 2}, std::vector<size_t>{2, 0, 1},
+                                               std::vector<size_t>{1}}) {
+        trading::HistoricalStream stream(path_, ids(symbols), trading::Timestamp::min(), trading::Timestamp::max(),
+                                         options);
+        auto ticks = drain(stream, options.batch_size);
+        auto want = expected(symbols, trading::Timestamp::min(), trading::Timestamp::max());
+        ASSERT_EQ(ticks.size(), want.size());
+        for (size_t i = 0; i < want.size(); ++i) {
+            ASSERT_EQ(ticks[i].symbol_id, want[i].symbol_id) << "row " << i;
+            ASSERT_EQ(ticks[i].timestamp, want[i].timestamp) << "row " << i;
+            ASSERT_EQ(ticks[i].last_price, want[i].last_price) << "row " << i;
+            ASSERT_EQ(ticks[i].volume, want[i].volume) << "row " << i;
+        }
+    }
+}
+
+TEST_P(HistoricalStreamTest, TrimsToRange) {
+    // Mid-morning of the first day to mid-morning of the second
+    auto start = trading::fromEpochNanos(kDay * kNanosPerDay + 35000 * kNanosPerSecond);
+    auto end = trading::fromEpochNanos((kDay + 1) * kNanosPerDay + 35001 * kNanosPerSecond);
+    trading::HistoricalStream::Options options;
+    options.batch_size = 512;
+    trading::HistoricalStream stream(path_, ids({0, 1, 2}), start, end, options);
+    auto ticks = drain(stream, options.batch_size);
+    auto want = expected({0, 1, 2}, start, end);
+    ASSERT_EQ(ticks.size(), want.size());
+    EXPECT_EQ(ticks.front().timestamp, start);
+    EXPECT_EQ(ticks.back().timestamp, want.back().timestamp);
+    EXPECT_EQ(stream.bufferBytes(), 3 * 512 * sizeof(trading::MarketData));
+}
+
+TEST_P(HistoricalStreamTest, SkipsMissingSymbolsAndEmptyRanges) {
+    trading::HistoricalStream::Options options;
+    trading::HistoricalStream missing(path_, {trading::internSymbol("STREAM_MISSING"), series_[1][0].symbol_id},
+                                      trading::Timestamp::min(), trading::Timestamp::max(), options);
+    EXPECT_EQ(drain(missing, options.batch_size).size(), series_[1].size());
+
+    auto night = trading::fromEpochNanos(kDay * kNanosPerDay + 3600 * kNanosPerSecond);
+    trading::HistoricalStream empty(path_, ids({0, 1}), night, night, options);
+    EXPECT_TRUE(empty.next().empty());
+}
+
+TEST_P(HistoricalStreamTest, StopsWithBatchesUnread) {
+    trading::HistoricalStream::Options options;
+    options.batch_size = 16;
+    options.prefetch = 2;
+    {
+        // The prefetch thread is blocked on full slots when this goes away
+        trading::HistoricalStream stream(path_, ids({0, 1, 2}), trading::Timestamp::min(),
+                                         trading::Timestamp::max(), options);
+        EXPECT_EQ(stream.next().size(), 16u);
+    }
+    {
+        trading::HistoricalStream unread(path_, ids({0}), trading::Timestamp::min(), trading::Timestamp::max(),
+                                         options);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, HistoricalStreamTest,
+                         ::testing::Values(trading::TickStoreWriter::Compression::NONE,
+                                           trading::TickStoreWriter::Compression::PACKED));
+
+TEST(HistoricalStreamErrorTest, RejectsBadArguments) {
+    trading::HistoricalStream::Options options;
+    EXPECT_THROW(trading::HistoricalStream("/tmp/historical_stream_missing.store", {}, trading::Timestamp::min(),
+                                           trading::Timestamp::max(), options),
+                 std::runtime_error);
+
+    std::string path = tempPath("historical_stream_errors");
+    {
+        trading::TickStoreWriter writer(path);
+        writer.finish();
+    }
+    options.batch_size = 0;
+    EXPECT_THROW(trading::HistoricalStream(path, {}, trading::Timestamp::min(), trading::Timestamp::max(), options),
+                 std::invalid_argument);
+    std::remove(path.c_str());
+}
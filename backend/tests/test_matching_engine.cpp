@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "matching_engine.hpp"
+#include <vector>
+
+namespace {
+
+struct EngineFixture {
+    explicit EngineFixture(trading::MatchingEngine::Options options = closedBook())
+        : engine(options), symbol(trading::internSymbol("AAPL")) {
+        engine.setReportSink([this](const trading::ExecutionReport& report) { reports.push_back(report); });
+    }
+
+    static trading::MatchingEngine::Options closedBook() {
+        trading::MatchingEngine::Options options;
+        options.outside_liquidity = false;
+        return options;
+    }
+
+    trading::Order order(trading::OrderSide side, trading::OrderType type, double quantity,
+                         double price = 0.0, double stop = 0.0) {
+        trading::Order order(symbol, side, type, quantity);
+        order.setPrice(price);
+        order.setStopPrice(stop);
+        return order;
+    }
+
+    // Total filled for one order across the reports so far
+    double filled(trading::OrderId id) const {
+        double total = 0.0;
+        for (const auto& report : reports) {
+            if (report.order_id == id && report.type == trading::ExecutionReport::Type::FILL) {
+                total += report.quantity;
+            }
+        }
+        return total;
+    }
+
+    bool has(trading::OrderId id, trading::ExecutionReport::Type type) const {
+        for (const auto& report : reports) {
+            if (report.order_id == id && report.type == type) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    trading::MatchingEngine engine;
+    trading::SymbolId symbol;
+    trading::Timestamp now{};
+    std::vector<trading::ExecutionReport> reports;
+};
+
+} // namespace
+
+TEST(MatchingEngineTest, PriceThenTimePriority) {
+    EngineFixture f;
+    auto early = f.order(trading::OrderSide::SELL, trading::OrderType::LIMIT, 10.0, 101.0);
+    auto late = f.order(trading::OrderSide::SELL, trading::OrderType::LIMIT, 10.0, 101.0);
+    auto better = f.order(trading::OrderSide::SELL, trading::OrderType::LIMIT, 10.0, 100.5);
+    f.engine.submit(early, f.now);
+    f.engine.submit(late, f.now);
+    f.engine.submit(better, f.now);
+    EXPECT_DOUBLE_EQ(f.engine.getBestAsk(f.symbol), 100.5);
+    EXPECT_TRUE(f.reports.empty());
+
+    auto buy = f.order(trading::OrderSide::BUY, trading::OrderType::LIMIT, 15.0, 101.0);
+    f.engine.submit(buy, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(better.getOrderId()), 10.0);
+    EXPECT_DOUBLE_EQ(f.filled(early.getOrderId()), 5.0);
+    EXPECT_DOUBLE_EQ(f.filled(late.getOrderId()), 0.0);
+    EXPECT_DOUBLE_EQ(f.filled(buy.getOrderId()), 15.0);
+    EXPECT_DOUBLE_EQ(f.engine.getLastPrice(f.symbol), 101.0);
+    EXPECT_EQ(f.engine.getOpenOrderCount(), 2u);
+}
+
+TEST(MatchingEngineTest, MarketOrdersCancelWhatTheyCannotFill) {
+    EngineFixture f;
+    auto ask = f.order(trading::OrderSide::SELL, trading::OrderType::LIMIT, 4.0, 100.0);
+    f.engine.submit(ask, f.now);
+
+    auto buy = f.order(trading::OrderSide::BUY, trading::OrderType::MARKET, 10.0);
+    f.engine.submit(buy, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(buy.getOrderId()), 4.0);
+    EXPECT_TRUE(f.has(buy.getOrderId(), trading::ExecutionReport::Type::CANCELLED));
+    EXPECT_EQ(f.engine.getOpenOrderCount(), 0u);
+
+    auto invalid = f.order(trading::OrderSide::BUY, trading::OrderType::LIMIT, 10.0, 0.0);
+    f.engine.submit(invalid, f.now);
+    EXPECT_TRUE(f.has(invalid.getOrderId(), trading::ExecutionReport::Type::REJECTED));
+}
+
+TEST(MatchingEngineTest, StopsTriggerOnTheLastTrade) {
+    EngineFixture f(trading::MatchingEngine::Options{});
+    f.engine.onTrade(f.symbol, 100.0, 0.0, f.now);
+
+    auto stop = f.order(trading::OrderSide::SELL, trading::OrderType::STOP, 5.0, 0.0, 98.0);
+    auto stop_limit = f.order(trading::OrderSide::BUY, trading::OrderType::STOP_LIMIT, 5.0, 102.5, 102.0);
+    f.engine.submit(stop, f.now);
+    f.engine.submit(stop_limit, f.now);
+    EXPECT_TRUE(f.reports.empty());
+
+    f.engine.onTrade(f.symbol, 99.0, 100.0, f.now);
+    EXPECT_TRUE(f.reports.empty());
+    f.engine.onTrade(f.symbol, 97.5, 100.0, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(stop.getOrderId()), 5.0);
+
+    // Triggered, but the limit is below the market, so it rests
+    f.engine.onTrade(f.symbol, 103.0, 0.0, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(stop_limit.getOrderId()), 0.0);
+    EXPECT_DOUBLE_EQ(f.engine.getBestBid(f.symbol), 102.5);
+    f.engine.onTrade(f.symbol, 102.5, 5.0, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(stop_limit.getOrderId()), 5.0);
+}
+
+TEST(MatchingEngineTest, QueuePositionDelaysTouchFills) {
+    trading::MatchingEngine::Options options;
+    options.queue_position = trading::QueuePosition::BEHIND;
+    options.queue_ahead = 300.0;
+    EngineFixture f(options);
+    f.engine.onTrade(f.symbol, 100.0, 0.0, f.now);
+
+    auto bid = f.order(trading::OrderSide::BUY, trading::OrderType::LIMIT, 100.0, 99.0);
+    f.engine.submit(bid, f.now);
+    f.engine.onTrade(f.symbol, 99.0, 250.0, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(bid.getOrderId()), 0.0);
+    f.engine.onTrade(f.symbol, 99.0, 80.0, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(bid.getOrderId()), 30.0);
+    // Trading through the price fills the rest
+    f.engine.onTrade(f.symbol, 98.5, 1.0, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(bid.getOrderId()), 100.0);
+}
+
+TEST(MatchingEngineTest, ReplaceKeepsPriorityOnlyWhenShrinking) {
+    EngineFixture f;
+    auto first = f.order(trading::OrderSide::BUY, trading::OrderType::LIMIT, 10.0, 99.0);
+    auto second = f.order(trading::OrderSide::BUY, trading::OrderType::LIMIT, 10.0, 99.0);
+    f.engine.submit(first, f.now);
+    f.engine.submit(second, f.now);
+
+    EXPECT_TRUE(f.engine.replace(first.getOrderId(), 8.0, 99.0, f.now));
+    auto sell = f.order(trading::OrderSide::SELL, trading::OrderType::LIMIT, 5.0, 99.0);
+    f.engine.submit(sell, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(first.getOrderId()), 5.0);
+
+    // Growing goes to the back of the queue
+    EXPECT_TRUE(f.engine.replace(first.getOrderId(), 20.0, 99.0, f.now));
+    auto sell_again = f.order(trading::OrderSide::SELL, trading::OrderType::LIMIT, 5.0, 99.0);
+    f.engine.submit(sell_again, f.now);
+    EXPECT_DOUBLE_EQ(f.filled(second.getOrderId()), 5.0);
+    EXPECT_DOUBLE_EQ(f.filled(first.getOrderId()), 5.0);
+
+    EXPECT_TRUE(f.engine.cancel(second.getOrderId(), f.now));
+    EXPECT_FALSE(f.engine.cancel(second.getOrderId(), f.now));
+    EXPECT_FALSE(f.engine.replace(first.getOrderId(), 2.0, 99.0, f.now));
+}
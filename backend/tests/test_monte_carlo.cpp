@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "monte_carlo.hpp"
+#include "common/philox.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+TEST(MonteCarloTest, PhiloxKnownAnswers) {
+    // Reference vectors from the Random123 distribution
+    trading::Philox4x32 zero(trading::Philox4x32::Key{0, 0});
+    auto out = zero({0, 0, 0, 0});
+    EXPECT_EQ(out[0], 0x6627e8d5u);
+    EXPECT_EQ(out[1], 0xe169c58du);
+    EXPECT_EQ(out[2], 0xbc57ac4cu);
+    EXPECT_EQ(out[3], 0x9b00dbd8u);
+
+    trading::Philox4x32 ones(trading::Philox4x32::Key{0xffffffff, 0xffffffff});
+    out = ones({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff});
+    EXPECT_EQ(out[0], 0x408f276du);
+    EXPECT_EQ(out[1], 0x41c83b0eu);
+    EXPECT_EQ(out[2], 0xa20bc7c6u);
+    EXPECT_EQ(out[3], 0x6d5451fdu);
+}
+
+namespace {
+
+// Single-asset model from a list of returns
+trading::MarketModel singleAsset(const std::vector<double>& returns, double exposure) {
+    trading::MarketModel model;
+    model.assets = 1;
+    model.samples = returns.size();
+    model.returns.assign(returns.begin(), returns.end());
+    model.exposures = {exposure};
+    return model;
+}
+
+} // namespace
+
+TEST(MonteCarloTest, HorizonSumsRowsDrawnWithReplacement) {
+    // Constant |return|, so the filter leaves every row as it is; the
+    // horizon P&L is 1000 times a sum of four +-1 draws
+    std::vector<double> returns;
+    for (int t = 0; t < 100; ++t) {
+        returns.push_back(t % 2 ? 0.01 : -0.01);
+    }
+    trading::MonteCarloEngine::Options options;
+    options.scenarios = 100000;
+    options.horizon = 4;
+    trading::MonteCarloResult result = trading::MonteCarloEngine(options).run(singleAsset(returns, 100000.0));
+
+    // Four losses in a row has probability 1/16 > 5%
+    EXPECT_EQ(result.scenarios, options.scenarios);
+    EXPECT_NEAR(result.var, 4000.0, 1e-6);
+    EXPECT_NEAR(result.expected_shortfall, 4000.0, 1e-6);
+}
+
+TEST(MonteCarloTest, FilterScalesShocksToCurrentVolatility) {
+    // Volatility triples halfway through the window
+    trading::Philox4x32 rng(7);
+    std::vector<double> returns;
+    for (uint32_t t = 0; t < 200; t += 4) {
+        auto z = rng.normals(0, t / 4);
+        for (double value : z) {
+            returns.push_back(value * (returns.size() < 100 ? 0.01 : 0.03));
+        }
+    }
+    trading::MonteCarloEngine::Options options;
+    options.scenarios = 200000;
+    trading::MonteCarloResult result = trading::MonteCarloEngine(options).run(singleAsset(returns, 100000.0));
+
+    // Plain historical VaR would mix both regimes
+    std::vector<double> sorted = returns;
+    std::sort(sorted.begin(), sorted.end());
+    double historical = -sorted[9] * 100000.0;
+    double current = trading::inverseNormalCdf(0.95) * 0.03 * 100000.0;
+    EXPECT_GT(result.var, historical);
+    EXPECT_NEAR(result.var, current, 0.25 * current);
+    EXPECT_GT(result.expected_shortfall, result.var);
+}
+
+TEST(MonteCarloTest, NeedsReturnHistory) {
+    trading::MonteCarloEngine engine;
+    EXPECT_EQ(engine.run(singleAsset({0.01}, 100000.0)).scenarios, 0u);
+
+    trading::MonteCarloEngine::Options options;
+    options.horizon = 0;
+    EXPECT_THROW(trading::MonteCarloEngine{options}, std::invalid_argument);
+}
+
+class MonteCarloModelTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Two assets with correlated, heavy-tailed returns
+        trading::Philox4x32 rng(11);
+        model_.assets = 2;
+        model_.samples = 250;
+        for (uint32_t t = 0; t < model_.samples; ++t) {
+            auto z = rng.normals(1, t);
+            double shock = z[0] * (t % 25 == 0 ? 4.0 : 1.0);
+            model_.returns.push_back(0.01 * shock);
+            model_.returns.push_back(0.01 * shock + 0.02 * z[1]);
+        }
+        model_.exposures = {100000.0, 50000.0};
+    }
+
+    trading::MarketModel model_;
+};
+
+TEST_F(MonteCarloModelTest, DeterministicAcrossThreadCounts) {
+    trading::MonteCarloEngine::Options options;
+    options.scenarios = 50000;
+    options.block_size = 1000;
+    options.horizon = 5;
+    options.threads = 1;
+    trading::MonteCarloResult single = trading::MonteCarloEngine(options).run(model_);
+    options.threads = 4;
+    trading::MonteCarloResult parallel = trading::MonteCarloEngine(options).run(model_);
+
+    EXPECT_GT(single.var, 0.0);
+    EXPECT_EQ(single.var, parallel.var);
+    EXPECT_EQ(single.expected_shortfall, parallel.expected_shortfall);
+}
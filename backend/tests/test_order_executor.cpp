@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "order_executor.hpp"
+#include <vector>
+
+namespace {
+
+// Records what the executor asks for; the test decides what the venue reports
+class ScriptedVenue : public trading::ExecutionVenue {
+public:
+    void submit(const trading::Order& order) override { submitted.push_back(order.getOrderId()); }
+    void cancel(trading::OrderId order_id) override {
+        send(trading::ExecutionReport::Type::CANCELLED, order_id, 0.0, 0.0);
+    }
+    void replace(trading::OrderId order_id, double quantity, double price) override {
+        send(trading::ExecutionReport::Type::REPLACED, order_id, quantity, price);
+    }
+    std::string describe() const override { return "scripted"; }
+
+    void send(trading::ExecutionReport::Type type, trading::OrderId order_id,
+              double quantity, double price) {
+        trading::ExecutionReport execution;
+        execution.type = type;
+        execution.order_id = order_id;
+        execution.quantity = quantity;
+        execution.price = price;
+        report(execution);
+    }
+
+    std::vector<trading::OrderId> submitted;
+};
+
+struct ExecutorFixture {
+    ExecutorFixture() : pool(8), executor(pool) {
+        auto owned = std::make_unique<ScriptedVenue>();
+        venue = owned.get();
+        executor.setVenue(std::move(owned));
+        executor.setUpdateHandler([this](trading::Span<const trading::OrderUpdate> batch) {
+            batches.push_back(batch.size());
+            updates.insert(updates.end(), batch.begin(), batch.end());
+        });
+    }
+
+    trading::Order* limitOrder(double quantity, double price) {
+        trading::Order* order = pool.acquire(trading::internSymbol("AAPL"), trading::OrderSide::BUY,
+                                             trading::OrderType::LIMIT, quantity);
+        order->setPrice(price);
+        return order;
+    }
+
+    trading::OrderPool pool;
+    trading::OrderExecutor executor;
+    ScriptedVenue* venue = nullptr;
+    std::vector<size_t> batches;
+    std::vector<trading::OrderUpdate> updates;
+};
+
+} // namespace
+
+TEST(OrderExecutorTest, PartialFillsAccumulateUntilFilled) {
+    ExecutorFixture f;
+    trading::Order* order = f.limitOrder(100.0, 50.0);
+    trading::OrderId id = order->getOrderId();
+
+    ASSERT_TRUE(f.executor.submitOrder(order));
+    f.executor.drain();
+    ASSERT_EQ(f.venue->submitted.size(), 1u);
+    EXPECT_EQ(f.executor.getOrderStatus(id), trading::OrderStatus::PENDING);
+
+    f.venue->send(trading::ExecutionReport::Type::FILL, id, 40.0, 50.0);
+    f.venue->send(trading::ExecutionReport::Type::FILL, id, 20.0, 49.0);
+    f.executor.drain();
+    EXPECT_EQ(f.executor.getOrderStatus(id), trading::OrderStatus::PARTIALLY_FILLED);
+    ASSERT_EQ(f.updates.size(), 2u);
+    EXPECT_DOUBLE_EQ(f.updates[1].fill_quantity, 20.0);
+    EXPECT_DOUBLE_EQ(f.updates[1].order.getFilledQuantity(), 60.0);
+    EXPECT_NEAR(f.updates[1].order.getAverageFillPrice(), (40.0 * 50.0 + 20.0 * 49.0) / 60.0, 1e-12);
+
+    // Overfills are clipped to the remaining quantity
+    f.venue->send(trading::ExecutionReport::Type::FILL, id, 75.0, 50.0);
+    f.executor.drain();
+    EXPECT_EQ(f.executor.getOrderStatus(id), trading::OrderStatus::FILLED);
+    EXPECT_DOUBLE_EQ(f.updates.back().fill_quantity, 40.0);
+    EXPECT_EQ(f.pool.inUse(), 0u);
+}
+
+TEST(OrderExecutorTest, ReplaceAndCancelResolveAgainstOpenOrders) {
+    ExecutorFixture f;
+    trading::Order* order = f.limitOrder(100.0, 50.0);
+    trading::OrderId id = order->getOrderId();
+    ASSERT_TRUE(f.executor.submitOrder(order));
+    f.executor.drain();
+
+    f.venue->send(trading::ExecutionReport::Type::FILL, id, 30.0, 50.0);
+    f.executor.drain();
+
+    // Cannot shrink below what has already filled
+    EXPECT_TRUE(f.executor.replaceOrder(id, 20.0, 51.0));
+    f.executor.drain();
+    EXPECT_EQ(f.updates.size(), 1u);
+
+    EXPECT_TRUE(f.executor.replaceOrder(id, 60.0, 51.0));
+    f.executor.drain();
+    ASSERT_EQ(f.updates.size(), 2u);
+    EXPECT_DOUBLE_EQ(f.updates.back().order.getQuantity(), 60.0);
+    EXPECT_DOUBLE_EQ(f.updates.back().order.getPrice(), 51.0);
+    EXPECT_DOUBLE_EQ(f.updates.back().order.getRemainingQuantity(), 30.0);
+
+    EXPECT_TRUE(f.executor.cancelOrder(id));
+    f.executor.drain();
+    EXPECT_EQ(f.executor.getOrderStatus(id), trading::OrderStatus::CANCELLED);
+    EXPECT_EQ(f.pool.inUse(), 0u);
+
+    // Once final the order no longer accepts instructions
+    EXPECT_TRUE(f.executor.cancelOrder(id));
+    f.executor.drain();
+    EXPECT_EQ(f.updates.size(), 3u);
+    EXPECT_FALSE(f.executor.getOrderStatus(id + 1000).has_value());
+}
+
+TEST(OrderExecutorTest, UpdatesAreDeliveredInBatches) {
+    ExecutorFixture f;
+    std::vector<trading::OrderId> ids;
+    for (int i = 0; i < 4; ++i) {
+        trading::Order* order = f.limitOrder(10.0, 50.0);
+        ids.push_back(order->getOrderId());
+        ASSERT_TRUE(f.executor.submitOrder(order));
+    }
+    f.executor.drain();
+    EXPECT_TRUE(f.batches.empty());
+
+    for (trading::OrderId id : ids) {
+        f.venue->send(trading::ExecutionReport::Type::FILL, id, 10.0, 50.0);
+    }
+    f.executor.drain();
+    ASSERT_EQ(f.batches.size(), 1u);
+    EXPECT_EQ(f.batches[0], 4u);
+    EXPECT_EQ(f.pool.inUse(), 0u);
+}
+
+TEST(OrderExecutorTest, ImmediateFillVenueRestsUntilMarketable) {
+    trading::PriceTable prices;
+    trading::MarketData tick;
+    tick.symbol_id = trading::internSymbol("AAPL");
+    tick.last_price = 52.0;
+    prices.update(tick);
+
+    trading::OrderPool pool(4);
+    trading::OrderExecutor executor(pool);
+    executor.setVenue(std::make_unique<trading::ImmediateFillVenue>(&prices));
+    std::vector<trading::OrderUpdate> updates;
+    executor.setUpdateHandler([&](trading::Span<const trading::OrderUpdate> batch) {
+        updates.insert(updates.end(), batch.begin(), batch.end());
+    });
+
+    trading::Order* order = pool.acquire(tick.symbol_id, trading::OrderSide::BUY,
+                                         trading::OrderType::LIMIT, 5.0);
+    order->setPrice(50.0);
+    trading::OrderId id = order->getOrderId();
+    ASSERT_TRUE(executor.submitOrder(order));
+    executor.drain();
+    EXPECT_TRUE(updates.empty());
+
+    // Raising the limit through the last price fills it
+    ASSERT_TRUE(executor.replaceOrder(id, 5.0, 53.0));
+    executor.drain();
+    ASSERT_EQ(updates.size(), 2u);
+    EXPECT_DOUBLE_EQ(updates[1].fill_quantity, 5.0);
+    EXPECT_DOUBLE_EQ(updates[1].fill_price, 52.0);
+    EXPECT_EQ(executor.getOrderStatus(id), trading::OrderStatus::FILLED);
+}
+
+TEST(OrderExecutorTest, ImmediateFillVenueFillsRestingOrdersOnPoll) {
+    trading::PriceTable prices;
+    trading::MarketData tick;
+    tick.symbol_id = trading::internSymbol("AAPL");
+    tick.last_price = 52.0;
+    prices.update(tick);
+
+    trading::OrderPool pool(4);
+    trading::OrderExecutor executor(pool);
+    executor.setVenue(std::make_unique<trading::ImmediateFillVenue>(&prices));
+    std::vector<trading::OrderUpdate> updates;
+    executor.setUpdateHandler([&](trading::Span<const trading::OrderUpdate> batch) {
+        updates.insert(updates.end(), batch.begin(), batch.end());
+    });
+
+    trading::Order* limit = pool.acquire(tick.symbol_id, trading::OrderSide::BUY,
+                                         trading::OrderType::LIMIT, 5.0);
+    limit->setPrice(50.0);
+    trading::Order* stop = pool.acquire(tick.symbol_id, trading::OrderSide::SELL,
+                                        trading::OrderType::STOP, 3.0);
+    stop->setStopPrice(49.0);
+    trading::OrderId limit_id = limit->getOrderId();
+    trading::OrderId stop_id = stop->getOrderId();
+    ASSERT_TRUE(executor.submitOrder(limit));
+    ASSERT_TRUE(executor.submitOrder(stop));
+    executor.drain();
+    EXPECT_TRUE(updates.empty());
+
+    // Down through the limit but above the stop
+    tick.last_price = 49.5;
+    prices.update(tick);
+    executor.drain();
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].order.getOrderId(), limit_id);
+    EXPECT_DOUBLE_EQ(updates[0].fill_price, 49.5);
+    EXPECT_EQ(executor.getOrderStatus(stop_id), trading::OrderStatus::PENDING);
+
+    tick.last_price = 48.0;
+    prices.update(tick);
+    executor.drain();
+    ASSERT_EQ(updates.size(), 2u);
+    EXPECT_EQ(updates[1].order.getOrderId(), stop_id);
+    EXPECT_DOUBLE_EQ(updates[1].fill_quantity, 3.0);
+    EXPECT_EQ(executor.getOrderStatus(stop_id), trading::OrderStatus::FILLED);
+    EXPECT_EQ(pool.inUse(), 0u);
+}
+
+TEST(OrderExecutorTest, IgnoresEmptyFills) {
+    ExecutorFixture f;
+    trading::Order* order = f.limitOrder(10.0, 50.0);
+    trading::OrderId id = order->getOrderId();
+    ASSERT_TRUE(f.executor.submitOrder(order));
+    f.executor.drain();
+
+    f.venue->send(trading::ExecutionReport::Type::FILL, id, 0.0, 50.0);
+    f.venue->send(trading::ExecutionReport::Type::FILL, id, -2.0, 50.0);
+    f.executor.drain();
+    EXPECT_TRUE(f.updates.empty());
+    EXPECT_EQ(f.executor.getOrderStatus(id), trading::OrderStatus::PENDING);
+
+    f.venue->send(trading::ExecutionReport::Type::FILL, id, 4.0, 50.0);
+    f.executor.drain();
+    ASSERT_EQ(f.updates.size(), 1u);
+    EXPECT_DOUBLE_EQ(f.updates[0].order.getAverageFillPrice(), 50.0);
+    EXPECT_EQ(f.updates[0].order.getStatus(), trading::OrderStatus::PARTIALLY_FILLED);
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "order_pool.hpp"
+#include <thread>
+
+TEST(OrderPoolTest, AcquireAssignsUniqueIdsAndReusesSlots) {
+    trading::OrderPool pool(2);
+    auto symbol = trading::internSymbol("AAPL");
+
+    trading::Order* first = pool.acquire(symbol, trading::OrderSide::BUY,
+                                         trading::OrderType::MARKET, 100.0);
+    trading::Order* second = pool.acquire(symbol, trading::OrderSide::SELL,
+                                          trading::OrderType::LIMIT, 50.0);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first->getOrderId(), second->getOrderId());
+    EXPECT_EQ(first->getSymbol(), symbol);
+    EXPECT_EQ(pool.acquire(symbol, trading::OrderSide::BUY,
+                           trading::OrderType::MARKET, 1.0), nullptr);
+
+    uint32_t index = pool.indexOf(first);
+    trading::OrderId old_id = first->getOrderId();
+    pool.release(first);
+    EXPECT_EQ(pool.inUse(), 1u);
+
+    trading::Order* reused = pool.acquire(symbol, trading::OrderSide::BUY,
+                                          trading::OrderType::MARKET, 1.0);
+    ASSERT_NE(reused, nullptr);
+    EXPECT_EQ(pool.indexOf(reused), index);
+    EXPECT_GT(reused->getOrderId(), old_id);
+}
+
+TEST(OrderPoolTest, ConcurrentAcquireRelease) {
+    trading::OrderPool pool(64);
+    auto symbol = trading::internSymbol("MSFT");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) {
+                trading::Order* order = pool.acquire(symbol, trading::OrderSide::BUY,
+                                                     trading::OrderType::MARKET, 1.0);
+                ASSERT_NE(order, nullptr);
+                pool.release(order);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(pool.inUse(), 0u);
+}
+
+TEST(OrderPoolTest, FormatsIdsOnlyAtTheEdge) {
+    EXPECT_EQ(trading::formatOrderId(42), "ORD42");
+}
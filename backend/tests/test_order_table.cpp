@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "order_table.hpp"
+#include <atomic>
+#include <thread>
+
+TEST(OrderTableTest, InsertFindAndStatus) {
+    trading::OrderTable table(16);
+    trading::Order order("AAPL", trading::OrderSide::BUY, trading::OrderType::MARKET, 10.0);
+
+    ASSERT_TRUE(table.insert(order.getOrderId(), &order, trading::OrderStatus::PENDING));
+    EXPECT_EQ(table.find(order.getOrderId()), &order);
+    EXPECT_EQ(table.find(order.getOrderId() + 1000), nullptr);
+
+    table.setStatus(order.getOrderId(), trading::OrderStatus::PARTIALLY_FILLED);
+    trading::OrderStatus status;
+    ASSERT_TRUE(table.getStatus(order.getOrderId(), status));
+    EXPECT_EQ(status, trading::OrderStatus::PARTIALLY_FILLED);
+
+    // A detached entry keeps answering status lookups
+    table.detach(order.getOrderId());
+    EXPECT_EQ(table.find(order.getOrderId()), nullptr);
+    EXPECT_TRUE(table.getStatus(order.getOrderId(), status));
+    EXPECT_FALSE(table.getStatus(order.getOrderId() + 1000, status));
+}
+
+TEST(OrderTableTest, EraseKeepsCollidingEntriesReachable) {
+    trading::OrderTable table(64);
+    EXPECT_EQ(table.capacity(), 64u);
+
+    // Enough keys to form long probe runs, then erase every other one
+    for (trading::OrderId id = 1; id <= 32; ++id) {
+        ASSERT_TRUE(table.insert(id, nullptr, trading::OrderStatus::PENDING));
+    }
+    EXPECT_FALSE(table.insert(33, nullptr, trading::OrderStatus::PENDING));
+    for (trading::OrderId id = 1; id <= 32; id += 2) {
+        EXPECT_TRUE(table.erase(id));
+    }
+    EXPECT_FALSE(table.erase(1));
+    EXPECT_EQ(table.size(), 16u);
+
+    trading::OrderStatus status;
+    for (trading::OrderId id = 1; id <= 32; ++id) {
+        EXPECT_EQ(table.getStatus(id, status), id % 2 == 0) << id;
+    }
+}
+
+TEST(OrderTableTest, ConcurrentReadersNeverMissLiveEntries) {
+    trading::OrderTable table(256);
+    // Ids 1..32 stay for the whole test while others churn around them
+    for (trading::OrderId id = 1; id <= 32; ++id) {
+        table.insert(id, nullptr, trading::OrderStatus::PENDING);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> misses{0};
+    std::thread reader([&] {
+        trading::OrderStatus status;
+        while (!done.load(std::memory_order_acquire)) {
+            for (trading::OrderId id = 1; id <= 32; ++id) {
+                if (!table.getStatus(id, status)) {
+                    misses.fetch_add(1);
+                }
+            }
+        }
+    });
+
+    for (int round = 0; round < 20000; ++round) {
+        trading::OrderId base = 1000 + static_cast<trading::OrderId>(round % 8) * 64;
+        for (trading::OrderId id = base; id < base + 64; ++id) {
+            table.insert(id, nullptr, trading::OrderStatus::PENDING);
+        }
+        for (trading::OrderId id = base; id < base + 64; ++id) {
+            table.erase(id);
+        }
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    EXPECT_EQ(misses.load(), 0);
+}
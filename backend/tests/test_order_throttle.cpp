@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "order_throttle.hpp"
+#include <cstdio>
+#include <fstream>
+
+namespace {
+    constexpr int64_t kSecond = 1000000000;
+}
+
+TEST(OrderThrottleTest, TokenBucketAllowsBurstThenRefills) {
+    trading::TokenBucket bucket;
+    bucket.configure(10.0, 3.0);  // 10/s, burst of 3
+
+    int64_t now = 5 * kSecond;
+    EXPECT_TRUE(bucket.tryAcquire(1.0, now));
+    EXPECT_TRUE(bucket.tryAcquire(1.0, now));
+    EXPECT_TRUE(bucket.tryAcquire(1.0, now));
+    EXPECT_FALSE(bucket.tryAcquire(1.0, now));
+
+    // One token back every 100ms
+    EXPECT_FALSE(bucket.tryAcquire(1.0, now + kSecond / 20));
+    EXPECT_TRUE(bucket.tryAcquire(1.0, now + kSecond / 10));
+    EXPECT_TRUE(bucket.tryAcquire(3.0, now + kSecond));
+}
+
+TEST(OrderThrottleTest, PerSymbolAndNotionalLimits) {
+    trading::OrderThrottle::Limits limits;
+    limits.max_notional_per_second = 100000.0;
+    limits.notional_burst = 100000.0;
+    limits.symbol_max_orders_per_second = 1.0;
+    limits.symbol_order_burst = 2.0;
+    trading::OrderThrottle throttle(limits, nullptr, 64);
+
+    trading::Order aapl("AAPL", trading::OrderSide::BUY, trading::OrderType::LIMIT, 100);
+    aapl.setPrice(100.0);
+    trading::Order msft("MSFT", trading::OrderSide::BUY, trading::OrderType::LIMIT, 100);
+    msft.setPrice(300.0);
+
+    int64_t now = kSecond;
+    EXPECT_EQ(throttle.check(aapl, now), trading::RiskRejectReason::NONE);
+    EXPECT_EQ(throttle.check(aapl, now), trading::RiskRejectReason::NONE);
+    EXPECT_EQ(throttle.check(aapl, now), trading::RiskRejectReason::ORDER_RATE);
+
+    // 20000 of notional used; 90000 more does not fit, 30000 does
+    trading::Order big("MSFT", trading::OrderSide::BUY, trading::OrderType::LIMIT, 300);
+    big.setPrice(300.0);
+    EXPECT_EQ(throttle.check(big, now), trading::RiskRejectReason::NOTIONAL_RATE);
+    EXPECT_EQ(throttle.check(msft, now), trading::RiskRejectReason::NONE);
+}
+
+TEST(OrderThrottleTest, KillSwitchFromApiAndFile) {
+    trading::OrderThrottle throttle(trading::OrderThrottle::Limits{});
+    trading::Order order("AAPL", trading::OrderSide::BUY, trading::OrderType::LIMIT, 1);
+    EXPECT_EQ(throttle.check(order), trading::RiskRejectReason::NONE);
+
+    throttle.killSwitch().engage("api");
+    EXPECT_EQ(throttle.check(order), trading::RiskRejectReason::KILL_SWITCH);
+    EXPECT_STREQ(throttle.killSwitch().getReason(), "api");
+    throttle.killSwitch().reset();
+    EXPECT_EQ(throttle.check(order), trading::RiskRejectReason::NONE);
+
+    std::string path = ::testing::TempDir() + "kill_switch_test";
+    std::remove(path.c_str());
+    throttle.killSwitch().setTriggerFile(path);
+    EXPECT_FALSE(throttle.killSwitch().pollTriggerFile());
+    std::ofstream(path) << "halt\n";
+    EXPECT_TRUE(throttle.killSwitch().pollTriggerFile());
+    EXPECT_EQ(throttle.check(order), trading::RiskRejectReason::KILL_SWITCH);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "parameter_sweep.hpp"
+#include "tick_file.hpp"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+std::vector<trading::MarketData> makeTicks(size_t count) {
+    std::vector<trading::MarketData> ticks(count);
+    trading::SymbolId symbol = trading::internSymbol("SWEEP");
+    for (size_t i = 0; i < count; ++i) {
+        ticks[i].symbol_id = symbol;
+        ticks[i].last_price = 100.0 + 10.0 * std::sin(static_cast<double>(i) / 15.0) + 0.01 * i;
+        ticks[i].volume = 100.0;
+        ticks[i].timestamp = trading::Timestamp(std::chrono::minutes(i + 1));
+    }
+    return ticks;
+}
+
+trading::SweepSpec movingAverageSpec() {
+    trading::SweepSpec spec;
+    spec.parameters = {{"short_period", 2, 10, 2, true}, {"long_period", 5, 40, 5, true}};
+    return spec;
+}
+
+} // namespace
+
+TEST(ParameterSweepTest, GridPointsCoverEveryCombination) {
+    auto points = trading::ParameterSweep::gridPoints(movingAverageSpec());
+    ASSERT_EQ(points.size(), 5u * 8u);
+    EXPECT_EQ(points.front(), (std::vector<double>{2, 5}));
+    EXPECT_EQ(points[1], (std::vector<double>{2, 10}));
+    EXPECT_EQ(points.back(), (std::vector<double>{10, 40}));
+}
+
+TEST(ParameterSweepTest, ResultsDoNotDependOnThreadCount) {
+    auto ticks = makeTicks(2000);
+    trading::ParameterSweep::Options options;
+    options.backtest.order_pool_capacity = 1024;
+
+    options.threads = 1;
+    auto serial = trading::ParameterSweep(trading::movingAverageFactory(), options)
+                      .run(movingAverageSpec(), ticks);
+    options.threads = 4;
+    auto parallel = trading::ParameterSweep(trading::movingAverageFactory(), options)
+                        .run(movingAverageSpec(), ticks);
+
+    // Combinations with long <= short are refused by the factory
+    ASSERT_FALSE(serial.empty());
+    EXPECT_LT(serial.size(), 40u);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].parameters, parallel[i].parameters);
+        EXPECT_DOUBLE_EQ(serial[i].score, parallel[i].score);
+        EXPECT_GT(serial[i].parameters[1], serial[i].parameters[0]);
+    }
+    EXPECT_GE(serial.front().score, serial.back().score);
+}
+
+TEST(ParameterSweepTest, RandomAndGeneticSearchAreReproducible) {
+    auto ticks = makeTicks(1000);
+    trading::ParameterSweep::Options options;
+    options.threads = 3;
+    trading::ParameterSweep sweep(trading::movingAverageFactory(), options);
+
+    trading::SweepSpec spec = movingAverageSpec();
+    spec.mode = trading::SweepSpec::Mode::RANDOM;
+    spec.samples = 20;
+    auto random = sweep.run(spec, ticks);
+    for (const auto& evaluation : random) {
+        EXPECT_EQ(std::fmod(evaluation.parameters[0], 2.0), 0.0);
+        EXPECT_EQ(std::fmod(evaluation.parameters[1], 5.0), 0.0);
+    }
+
+    spec.mode = trading::SweepSpec::Mode::GENETIC;
+    spec.genetic.population = 12;
+    spec.genetic.generations = 4;
+    auto first = sweep.run(spec, ticks);
+    auto second = sweep.run(spec, ticks);
+    ASSERT_FALSE(first.empty());
+    ASSERT_EQ(first.size(), second.size());
+    EXPECT_EQ(first.front().parameters, second.front().parameters);
+    EXPECT_DOUBLE_EQ(first.front().score, second.front().score);
+}
+
+TEST(TickFileTest, RoundTripsThroughMapping) {
+    auto ticks = makeTicks(500);
+    std::string path = "/tmp/test_tick_file_" + std::to_string(::getpid()) + ".bin";
+    trading::TickFile::write(path, ticks);
+    {
+        trading::TickFile file(path);
+        ASSERT_EQ(file.size(), ticks.size());
+        EXPECT_DOUBLE_EQ(file.ticks()[123].last_price, ticks[123].last_price);
+        EXPECT_EQ(file.ticks()[499].timestamp, ticks[499].timestamp);
+    }
+    std::remove(path.c_str());
+    EXPECT_THROW(trading::TickFile("/nonexistent/ticks.bin"), std::runtime_error);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "portfolio.hpp"
+#include <cmath>
+
+class PortfolioTest : public ::testing::Test {
+protected:
+    trading::SymbolId aapl_ = trading::internSymbol("AAPL");
+    trading::SymbolId msft_ = trading::internSymbol("MSFT");
+    trading::Portfolio portfolio_{100000.0};
+};
+
+TEST_F(PortfolioTest, FillsAndMarksUpdateRunningValue) {
+    portfolio_.applyFill(aapl_, 100, 200.0);
+    portfolio_.applyFill(msft_, -50, 400.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getTotalValue(), 100000.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getTotalExposure(), 40000.0);
+
+    portfolio_.markPrice(aapl_, 210.0);
+    portfolio_.markPrice(msft_, 390.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getUnrealizedPnL(), 1000.0 + 500.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getTotalValue(), 101500.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getTotalExposure(), 21000.0 + 19500.0);
+    EXPECT_NEAR(portfolio_.getConcentration(aapl_), 21000.0 / 101500.0, 1e-12);
+    EXPECT_NEAR(portfolio_.getConcentration(), 21000.0 / 101500.0, 1e-12);
+}
+
+TEST_F(PortfolioTest, ClosingRealizesPnL) {
+    portfolio_.applyFill(aapl_, 100, 200.0);
+    portfolio_.applyFill(aapl_, -60, 210.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getRealizedPnL(), 600.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getPosition(aapl_)->getAveragePrice(), 200.0);
+
+    // Flip short: remaining 40 closed, new short of 10 at 220
+    portfolio_.applyFill(aapl_, -50, 220.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getRealizedPnL(), 600.0 + 800.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getPosition(aapl_)->getQuantity(), -10.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getPosition(aapl_)->getAveragePrice(), 220.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getTotalValue(), 100000.0 + 1400.0);
+}
+
+TEST_F(PortfolioTest, EmptyFillOnFlatPositionKeepsValuesFinite) {
+    portfolio_.updatePosition(aapl_, 0, 200.0);
+    portfolio_.applyFill(msft_, 0, 400.0);
+    EXPECT_EQ(portfolio_.getPosition(aapl_)->getAveragePrice(), 0.0);
+    EXPECT_EQ(portfolio_.getPosition(msft_)->getAveragePrice(), 0.0);
+
+    portfolio_.applyFill(aapl_, 100, 200.0);
+    portfolio_.markPrice(aapl_, 210.0);
+    EXPECT_TRUE(std::isfinite(portfolio_.getTotalValue()));
+    EXPECT_DOUBLE_EQ(portfolio_.getTotalValue(), 101000.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getUnrealizedPnL(), 1000.0);
+}
+
+TEST_F(PortfolioTest, ConcentrationFollowsLargestPosition) {
+    portfolio_.applyFill(aapl_, 100, 200.0);
+    portfolio_.applyFill(msft_, 25, 400.0);
+    portfolio_.markPrice(aapl_, 50.0);
+
+    double expected = 10000.0 / portfolio_.getTotalValue();
+    EXPECT_NEAR(portfolio_.getConcentration(), expected, 1e-12);
+}
+
+TEST_F(PortfolioTest, TracksDrawdownFromHighWaterMark) {
+    portfolio_.applyFill(aapl_, 100, 200.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getHighWaterMark(), 100000.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getDrawdown(), 0.0);
+
+    portfolio_.markPrice(aapl_, 300.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getHighWaterMark(), 110000.0);
+
+    portfolio_.markPrice(aapl_, 190.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getHighWaterMark(), 110000.0);
+    EXPECT_NEAR(portfolio_.getDrawdown(), 11000.0 / 110000.0, 1e-12);
+    EXPECT_DOUBLE_EQ(portfolio_.getDailyPnL(), -1000.0);
+}
+
+TEST_F(PortfolioTest, SessionRollResetsDailyPnL) {
+    using namespace std::chrono;
+    // Sessions roll at 21:00 UTC
+    portfolio_.setSessionRoll(hours(21));
+    trading::Timestamp day(hours(24 * 20000));
+    portfolio_.advanceClock(day + hours(10));
+
+    portfolio_.applyFill(aapl_, 100, 200.0, 5.0);
+    portfolio_.markPrice(aapl_, 210.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getDailyPnL(), 995.0);
+
+    portfolio_.advanceClock(day + hours(20));
+    EXPECT_DOUBLE_EQ(portfolio_.getDailyPnL(), 995.0);
+
+    portfolio_.advanceClock(day + hours(21));
+    EXPECT_DOUBLE_EQ(portfolio_.getDailyPnL(), 0.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getSessionStartValue(), 100995.0);
+
+    portfolio_.markPrice(aapl_, 205.0);
+    EXPECT_DOUBLE_EQ(portfolio_.getDailyPnL(), -500.0);
+
+    // Next boundary is a day later
+    portfolio_.advanceClock(day + hours(44));
+    EXPECT_DOUBLE_EQ(portfolio_.getDailyPnL(), -500.0);
+    portfolio_.advanceClock(day + hours(45));
+    EXPECT_DOUBLE_EQ(portfolio_.getDailyPnL(), 0.0);
+}
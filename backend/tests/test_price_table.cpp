@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "price_table.hpp"
+#include <thread>
+
+TEST(PriceTableTest, ReturnsLatestTick) {
+    trading::PriceTable table(16);
+    auto symbol = trading::internSymbol("AAPL");
+
+    trading::Quote quote;
+    EXPECT_FALSE(table.getQuote(symbol, quote));
+    EXPECT_DOUBLE_EQ(table.getLastPrice(symbol), 0.0);
+
+    trading::MarketData data;
+    data.symbol_id = symbol;
+    data.last_price = 190.25;
+    data.volume = 500;
+    table.update(data);
+
+    ASSERT_TRUE(table.getQuote(symbol, quote));
+    EXPECT_DOUBLE_EQ(quote.last_price, 190.25);
+    EXPECT_DOUBLE_EQ(quote.volume, 500);
+}
+
+TEST(PriceTableTest, ReadersNeverSeeTornQuotes) {
+    trading::SeqLock<trading::Quote> slot;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (int i = 1; i <= 200000; ++i) {
+            trading::Quote quote;
+            quote.last_price = i;
+            quote.bid = i;
+            quote.ask = i;
+            quote.volume = i;
+            slot.store(quote);
+        }
+        done = true;
+    });
+
+    while (!done) {
+        trading::Quote quote = slot.load();
+        ASSERT_EQ(quote.last_price, quote.bid);
+        ASSERT_EQ(quote.last_price, quote.ask);
+        ASSERT_EQ(quote.last_price, quote.volume);
+    }
+    writer.join();
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "common/ring_queue.hpp"
+#include <thread>
+
+TEST(SpscQueueTest, PreservesOrderAndReportsFull) {
+    trading::SpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, DeliversEveryItemFromAllProducers) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 10000;
+    trading::MpscQueue<int> queue(256);
+    trading::QueueWaiter waiter(trading::WaitStrategy::BLOCK);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!queue.tryPush(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+                waiter.notify();
+            }
+        });
+    }
+
+    std::vector<int> last_seen(kProducers, -1);
+    int received = 0;
+    while (received < kProducers * kPerProducer) {
+        int value;
+        if (!queue.tryPop(value)) {
+            waiter.waitUntil([&] { return !queue.empty(); },
+                             std::chrono::steady_clock::now() + std::chrono::seconds(1));
+            continue;
+        }
+        // Items from one producer arrive in the order they were pushed
+        int producer = value / kPerProducer;
+        EXPECT_GT(value, last_seen[producer]);
+        last_seen[producer] = value;
+        ++received;
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "risk_checks.hpp"
+
+namespace {
+    trading::RiskLimits limits() {
+        return {.max_position_size = 0.1,
+                .max_drawdown = 0.2,
+                .max_leverage = 2.0,
+                .daily_loss_limit = 0.01,
+                .position_concentration = 0.3};
+    }
+
+    trading::OrderRiskContext context() {
+        trading::OrderRiskContext c{};
+        c.portfolio_value = 1000000.0;
+        c.session_start_value = 1000000.0;
+        c.order_value = 50000.0;
+        c.new_exposure = 50000.0;
+        c.total_exposure = 50000.0;
+        return c;
+    }
+
+    // A deployment-specific check added without touching RiskManager
+    struct NoShortingCheck {
+        static constexpr trading::RiskRejectReason kReason = trading::RiskRejectReason::CONCENTRATION;
+        static bool violated(const trading::OrderRiskContext& c, const trading::RiskLimits&) {
+            return c.order_value < 0.0;
+        }
+    };
+}
+
+TEST(RiskChecksTest, ReportsFirstFailureInChainOrder) {
+    trading::OrderRiskContext c = context();
+    EXPECT_TRUE(trading::DefaultRiskChecks::evaluate(c, limits()).accepted());
+
+    c.daily_pnl = -20000.0;
+    c.new_exposure = 400000.0;
+    EXPECT_EQ(trading::DefaultRiskChecks::evaluate(c, limits()).reason,
+              trading::RiskRejectReason::DAILY_LOSS);
+
+    using ConcentrationFirst = trading::RiskCheckChain<trading::ConcentrationCheck,
+                                                       trading::DailyLossCheck>;
+    EXPECT_EQ(ConcentrationFirst::evaluate(c, limits()).reason,
+              trading::RiskRejectReason::CONCENTRATION);
+}
+
+TEST(RiskChecksTest, ChainsOnlyRunTheirChecks) {
+    trading::OrderRiskContext c = context();
+    c.daily_pnl = -20000.0;
+
+    EXPECT_EQ(trading::EquityRiskChecks::evaluate(c, limits()).reason,
+              trading::RiskRejectReason::DAILY_LOSS);
+    EXPECT_TRUE(trading::CryptoRiskChecks::evaluate(c, limits()).accepted());
+    EXPECT_TRUE(trading::RiskCheckChain<>::evaluate(c, limits()).accepted());
+
+    c.order_value = -1.0;
+    EXPECT_EQ(trading::RiskCheckChain<NoShortingCheck>::evaluate(c, limits()).reason,
+              trading::RiskRejectReason::CONCENTRATION);
+}
+
+TEST(RiskChecksTest, DailyLossIsAFractionOfSessionStartAndAllowsExits) {
+    trading::OrderRiskContext c = context();
+    c.daily_pnl = -9000.0;
+    EXPECT_TRUE(trading::DefaultRiskChecks::evaluate(c, limits()).accepted());
+
+    c.daily_pnl = -11000.0;
+    EXPECT_EQ(trading::DefaultRiskChecks::evaluate(c, limits()).reason,
+              trading::RiskRejectReason::DAILY_LOSS);
+
+    // Selling down a losing position is still allowed
+    c.current_exposure = 80000.0;
+    c.new_exposure = 30000.0;
+    EXPECT_TRUE(trading::DefaultRiskChecks::evaluate(c, limits()).accepted());
+}
+
+TEST(RiskChecksTest, TailChecksOnlyBlockRiskIncreasingOrders) {
+    trading::RiskLimits l = limits();
+    l.max_var = 0.01;
+    trading::OrderRiskContext c = context();
+    c.tail.var = 20000.0;
+
+    c.current_exposure = 10000.0;
+    EXPECT_EQ(trading::DefaultRiskChecks::evaluate(c, l).reason, trading::RiskRejectReason::VAR);
+
+    c.current_exposure = 60000.0;
+    EXPECT_TRUE(trading::DefaultRiskChecks::evaluate(c, l).accepted());
+}
@@ -8,7 +8,7 @@ protected:
             .max_position_size = 0.1,
             .max_drawdown = 0.2,
             .max_leverage = 2.0,
-            .daily_loss_limit = 10000.0,
+            .daily_loss_limit = 0.01,
             .position_concentration = 0.3
         };
         risk_manager_ = std::make_unique<trading::RiskManager>(limits);
@@ -23,4 +23,197 @@ TEST_F(RiskManagerTest, CheckOrderRisk) {
     trading::Portfolio portfolio;
     
     EXPECT_TRUE(risk_manager_->checkOrderRisk(order, portfolio));
-} 
\ No newline at end of file
+}
+
+TEST_F(RiskManagerTest, PublishesMetricsSnapshot) {
+    trading::Portfolio portfolio;
+    portfolio.applyFill(trading::internSymbol("AAPL"), 1000, 100.0);
+    EXPECT_EQ(risk_manager_->getMetricsVersion(), 0u);
+
+    risk_manager_->updateRiskMetrics(portfolio);
+
+    trading::RiskMetrics metrics = risk_manager_->getRiskMetrics();
+    EXPECT_EQ(risk_manager_->getMetricsVersion(), 1u);
+    EXPECT_DOUBLE_EQ(metrics.total_value, 1000000.0);
+    EXPECT_DOUBLE_EQ(metrics.total_exposure, 100000.0);
+    EXPECT_DOUBLE_EQ(metrics.leverage, 0.1);
+    EXPECT_DOUBLE_EQ(metrics.concentration, 0.1);
+}
+
+TEST_F(RiskManagerTest, RejectsWithReasonCode) {
+    trading::Portfolio portfolio;
+    trading::PriceTable prices(64);
+    trading::MarketData tick;
+    tick.symbol_id = trading::internSymbol("AAPL");
+    tick.last_price = 100.0;
+    prices.update(tick);
+
+    trading::RiskManager::RiskLimits limits{
+        .max_position_size = 0.1,
+        .max_drawdown = 0.2,
+        .max_leverage = 2.0,
+        .daily_loss_limit = 0.01,
+        .position_concentration = 0.3
+    };
+    trading::RiskManager risk_manager(limits, &prices);
+
+    trading::Order small("AAPL", trading::OrderSide::BUY, trading::OrderType::MARKET, 500);
+    EXPECT_TRUE(risk_manager.checkOrder(small, portfolio).accepted());
+
+    trading::Order large("AAPL", trading::OrderSide::BUY, trading::OrderType::MARKET, 2000);
+    EXPECT_EQ(risk_manager.checkOrder(large, portfolio).reason,
+              trading::RiskRejectReason::POSITION_SIZE);
+
+    // Existing 2500 share position pushes the next buy over 30% concentration
+    portfolio.applyFill(tick.symbol_id, 2500, 100.0);
+    trading::Order add("AAPL", trading::OrderSide::BUY, trading::OrderType::MARKET, 600);
+    EXPECT_EQ(risk_manager.checkOrder(add, portfolio).reason,
+              trading::RiskRejectReason::CONCENTRATION);
+
+    // Selling reduces exposure and passes
+    trading::Order reduce("AAPL", trading::OrderSide::SELL, trading::OrderType::MARKET, 600);
+    EXPECT_TRUE(risk_manager.checkOrder(reduce, portfolio).accepted());
+
+    trading::Order unpriced("NOPRICE", trading::OrderSide::BUY, trading::OrderType::MARKET, 1);
+    EXPECT_EQ(risk_manager.checkOrder(unpriced, portfolio).reason,
+              trading::RiskRejectReason::NO_PRICE);
+}
+
+TEST_F(RiskManagerTest, BatchCarriesExposureForward) {
+    trading::Portfolio portfolio;
+    trading::PriceTable prices(64);
+    trading::MarketData tick;
+    tick.symbol_id = trading::internSymbol("AAPL");
+    tick.last_price = 100.0;
+    prices.update(tick);
+
+    trading::RiskManager::RiskLimits limits{
+        .max_position_size = 0.1,
+        .max_drawdown = 0.2,
+        .max_leverage = 2.0,
+        .daily_loss_limit = 0.01,
+        .position_concentration = 0.3
+    };
+    trading::RiskManager risk_manager(limits, &prices);
+
+    // Each buy passes alone; the fourth breaches 30% concentration
+    trading::Order buy("AAPL", trading::OrderSide::BUY, trading::OrderType::MARKET, 900);
+    trading::Order sell("AAPL", trading::OrderSide::SELL, trading::OrderType::MARKET, 900);
+    std::vector<const trading::Order*> orders{&buy, &buy, &buy, &buy, &sell, &buy};
+
+    auto verdicts = risk_manager.checkOrderBatch(orders, portfolio);
+    ASSERT_EQ(verdicts.size(), orders.size());
+    EXPECT_TRUE(verdicts[0].accepted());
+    EXPECT_TRUE(verdicts[1].accepted());
+    EXPECT_TRUE(verdicts[2].accepted());
+    EXPECT_EQ(verdicts[3].reason, trading::RiskRejectReason::CONCENTRATION);
+    // Rejected orders are not carried forward; the sell frees room again
+    EXPECT_TRUE(verdicts[4].accepted());
+    EXPECT_TRUE(verdicts[5].accepted());
+}
+
+TEST_F(RiskManagerTest, BatchWritesIntoCallerBuffer) {
+    trading::Portfolio portfolio;
+    trading::Order small("AAPL", trading::OrderSide::BUY, trading::OrderType::LIMIT, 100);
+    small.setPrice(100.0);
+    trading::Order large("AAPL", trading::OrderSide::BUY, trading::OrderType::LIMIT, 5000);
+    large.setPrice(100.0);
+    std::vector<const trading::Order*> orders{&small, &large};
+
+    std::vector<trading::RiskVerdict> verdicts(2);
+    risk_manager_->checkOrderBatch(orders, portfolio, verdicts);
+    EXPECT_TRUE(verdicts[0].accepted());
+    EXPECT_EQ(verdicts[1].reason, trading::RiskRejectReason::POSITION_SIZE);
+
+    std::vector<trading::RiskVerdict> short_buffer(1);
+    EXPECT_THROW(risk_manager_->checkOrderBatch(orders, portfolio, short_buffer), std::invalid_argument);
+}
+
+TEST_F(RiskManagerTest, BatchTracksManySymbols) {
+    trading::Portfolio portfolio;
+    trading::PriceTable prices;
+    trading::RiskManager::RiskLimits limits{
+        .max_position_size = 0.1,
+        .max_drawdown = 0.2,
+        .max_leverage = 2.0,
+        .daily_loss_limit = 0.01,
+        .position_concentration = 0.03
+    };
+    trading::RiskManager risk_manager(limits, &prices);
+
+    // More symbols than the inline slots; each takes two 2% buys and
+    // rejects the second, which would breach 3% concentration
+    std::vector<trading::Order> buys;
+    for (int i = 0; i < 40; ++i) {
+        trading::MarketData tick;
+        tick.symbol_id = trading::internSymbol("BATCH" + std::to_string(i));
+        tick.last_price = 100.0;
+        prices.update(tick);
+        buys.emplace_back(tick.symbol_id, trading::OrderSide::BUY, trading::OrderType::MARKET, 200);
+    }
+    std::vector<const trading::Order*> orders;
+    for (const auto& buy : buys) {
+        orders.push_back(&buy);
+    }
+    for (const auto& buy : buys) {
+        orders.push_back(&buy);
+    }
+
+    auto verdicts = risk_manager.checkOrderBatch(orders, portfolio);
+    ASSERT_EQ(verdicts.size(), 80u);
+    for (size_t i = 0; i < 40; ++i) {
+        EXPECT_TRUE(verdicts[i].accepted()) << "order " << i;
+        EXPECT_EQ(verdicts[40 + i].reason, trading::RiskRejectReason::CONCENTRATION) << "order " << 40 + i;
+    }
+}
+
+TEST_F(RiskManagerTest, TailRiskLimitOnlyAllowsReducingOrders) {
+    trading::RiskManager::RiskLimits limits{
+        .max_position_size = 0.1,
+        .max_drawdown = 0.2,
+        .max_leverage = 2.0,
+        .daily_loss_limit = 0.01,
+        .position_concentration = 0.3,
+        .max_var = 0.02
+    };
+    trading::RiskManager risk_manager(limits);
+    trading::Portfolio portfolio;
+    portfolio.applyFill(trading::internSymbol("AAPL"), 1000, 100.0);
+
+    trading::Order buy("AAPL", trading::OrderSide::BUY, trading::OrderType::LIMIT, 100);
+    buy.setPrice(100.0);
+    trading::Order sell("AAPL", trading::OrderSide::SELL, trading::OrderType::LIMIT, 100);
+    sell.setPrice(100.0);
+
+    risk_manager.updateTailRisk(10000.0, 15000.0);
+    EXPECT_TRUE(risk_manager.checkOrder(buy, portfolio).accepted());
+
+    risk_manager.updateTailRisk(25000.0, 30000.0);
+    EXPECT_EQ(risk_manager.checkOrder(buy, portfolio).reason, trading::RiskRejectReason::VAR);
+    EXPECT_TRUE(risk_manager.checkOrder(sell, portfolio).accepted());
+}
+
+TEST_F(RiskManagerTest, DrawdownAndDailyLossLimitsApply) {
+    trading::Portfolio portfolio;
+    auto symbol = trading::internSymbol("AAPL");
+    portfolio.applyFill(symbol, 3000, 100.0);
+
+    trading::Order buy("AAPL", trading::OrderSide::BUY, trading::OrderType::LIMIT, 10);
+    buy.setPrice(50.0);
+    EXPECT_TRUE(risk_manager_->checkOrder(buy, portfolio).accepted());
+
+    // A 30000 loss breaches the 1% daily limit but is only a 3% drawdown
+    portfolio.markPrice(symbol, 90.0);
+    EXPECT_EQ(risk_manager_->checkOrder(buy, portfolio).reason,
+              trading::RiskRejectReason::DAILY_LOSS);
+
+    // The losing position can still be cut
+    trading::Order sell("AAPL", trading::OrderSide::SELL, trading::OrderType::LIMIT, 100);
+    sell.setPrice(90.0);
+    EXPECT_TRUE(risk_manager_->checkOrder(sell, portfolio).accepted());
+
+    // A 210000 loss is a 21% drawdown, reported ahead of the daily loss
+    portfolio.markPrice(symbol, 30.0);
+    EXPECT_EQ(risk_manager_->checkOrder(buy, portfolio).reason,
+              trading::RiskRejectReason::DRAWDOWN);
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include "common/rolling_window.hpp"
+
+TEST(RollingWindowTest, MeanTracksLastValues) {
+    trading::RollingWindow<double> window(3);
+    window.push(1.0);
+    window.push(2.0);
+    EXPECT_FALSE(window.full());
+    EXPECT_DOUBLE_EQ(window.mean(), 1.5);
+
+    window.push(3.0);
+    window.push(4.0);
+    EXPECT_TRUE(window.full());
+    EXPECT_EQ(window.size(), 3u);
+    EXPECT_DOUBLE_EQ(window.mean(), 3.0);
+    EXPECT_DOUBLE_EQ(window.oldest(), 2.0);
+    EXPECT_DOUBLE_EQ(window.newest(), 4.0);
+    EXPECT_DOUBLE_EQ(window.variance(), 1.0);
+}
+
+TEST(RollingWindowTest, RunningSumDoesNotDrift) {
+    trading::RollingWindow<double> window(200);
+    for (int i = 0; i < 1000000; ++i) {
+        window.push(100.0 + 0.01 * (i % 97));
+    }
+
+    double expected = 0.0;
+    for (size_t i = 0; i < window.size(); ++i) {
+        expected += window[i];
+    }
+    EXPECT_NEAR(window.sum(), expected, 1e-9);
+}
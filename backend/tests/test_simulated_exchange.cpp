@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "order_executor.hpp"
+#include "simulated_exchange.hpp"
+#include <vector>
+
+namespace {
+    trading::Timestamp at(int64_t micros) {
+        return trading::Timestamp(std::chrono::microseconds(micros));
+    }
+}
+
+TEST(SimulatedExchangeTest, LatencyDelaysRequestsAndReports) {
+    trading::SimulatedExchange::Options options;
+    options.simulated_clock = true;
+    options.latency.order_latency = std::chrono::microseconds(100);
+    options.latency.report_latency = std::chrono::microseconds(50);
+
+    trading::OrderPool pool(4);
+    trading::OrderExecutor executor(pool);
+    auto owned = std::make_unique<trading::SimulatedExchange>(options);
+    trading::SimulatedExchange* exchange = owned.get();
+    executor.setVenue(std::move(owned));
+    std::vector<trading::OrderUpdate> updates;
+    executor.setUpdateHandler([&](trading::Span<const trading::OrderUpdate> batch) {
+        updates.insert(updates.end(), batch.begin(), batch.end());
+    });
+
+    trading::SymbolId symbol = trading::internSymbol("MSFT");
+    exchange->onTrade(symbol, 200.0, 0.0, at(1000));
+
+    trading::Order* order = pool.acquire(symbol, trading::OrderSide::BUY, trading::OrderType::MARKET, 10.0);
+    trading::OrderId id = order->getOrderId();
+    ASSERT_TRUE(executor.submitOrder(order));
+    executor.drain();
+    EXPECT_FALSE(exchange->idle());
+
+    // The price moves before the order arrives at 1100us
+    exchange->onTrade(symbol, 201.0, 0.0, at(1050));
+    exchange->advanceTo(at(1120));
+    executor.drain();
+    EXPECT_TRUE(updates.empty());
+
+    exchange->advanceTo(at(1150));
+    executor.drain();
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_DOUBLE_EQ(updates[0].fill_price, 201.0);
+    EXPECT_EQ(updates[0].order.getUpdateTime(), at(1100));
+    EXPECT_EQ(executor.getOrderStatus(id), trading::OrderStatus::FILLED);
+    EXPECT_TRUE(exchange->idle());
+}
+
+TEST(SimulatedExchangeTest, JitterIsReproducibleAndKeepsOrder) {
+    auto run = [](uint64_t seed) {
+        trading::SimulatedExchange::Options options;
+        options.simulated_clock = true;
+        options.latency.order_latency = std::chrono::microseconds(10);
+        options.latency.jitter = std::chrono::microseconds(40);
+        options.latency.seed = seed;
+        trading::SimulatedExchange exchange(options);
+        std::vector<trading::ExecutionReport> reports;
+        exchange.setReportSink([&](const trading::ExecutionReport& report) { reports.push_back(report); });
+
+        trading::SymbolId symbol = trading::internSymbol("MSFT");
+        exchange.onTrade(symbol, 100.0, 0.0, at(0));
+        for (int i = 0; i < 20; ++i) {
+            trading::Order order(symbol, trading::OrderSide::SELL, trading::OrderType::MARKET, 1.0);
+            exchange.submit(order);
+        }
+        exchange.advanceTo(at(1000));
+        std::vector<trading::Timestamp> times;
+        for (const auto& report : reports) {
+            times.push_back(report.timestamp);
+        }
+        return times;
+    };
+
+    std::vector<trading::Timestamp> first = run(7);
+    ASSERT_EQ(first.size(), 20u);
+    EXPECT_EQ(first, run(7));
+    EXPECT_NE(first, run(8));
+    EXPECT_TRUE(std::is_sorted(first.begin(), first.end()));
+    EXPECT_GE(first.front(), at(10));
+    EXPECT_LT(first.back(), at(1000));
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "strategy.hpp"
+
+class MovingAverageStrategyTest : public ::testing::Test {
+protected:
+    trading::MarketData makeTick(trading::SymbolId symbol, double price) {
+        trading::MarketData data;
+        data.symbol_id = symbol;
+        data.last_price = price;
+        return data;
+    }
+
+    trading::MovingAverageStrategy strategy_{2, 4};
+};
+
+TEST_F(MovingAverageStrategyTest, KeepsSeriesSeparatePerSymbol) {
+    auto rising = trading::internSymbol("RISING");
+    auto falling = trading::internSymbol("FALLING");
+
+    std::vector<trading::Strategy::Signal> last_rising;
+    std::vector<trading::Strategy::Signal> last_falling;
+    for (int i = 0; i < 4; ++i) {
+        last_rising = strategy_.onMarketData(makeTick(rising, 100.0 + i));
+        last_falling = strategy_.onMarketData(makeTick(falling, 100.0 - i));
+    }
+
+    ASSERT_EQ(last_rising.size(), 1u);
+    ASSERT_EQ(last_falling.size(), 1u);
+    EXPECT_EQ(last_rising[0].symbol, rising);
+    EXPECT_EQ(last_rising[0].side, trading::OrderSide::BUY);
+    EXPECT_EQ(last_falling[0].side, trading::OrderSide::SELL);
+}
+
+TEST(SymbolStateTableTest, ShardsPartitionSymbols) {
+    trading::SymbolStateTable<int> table(8);
+    for (trading::SymbolId id = 0; id < 8; ++id) {
+        table.getOrCreate(id, static_cast<int>(id));
+    }
+
+    int visited = 0;
+    for (size_t shard = 0; shard < 3; ++shard) {
+        table.forEachInShard(shard, 3, [&](trading::SymbolId id, int& value) {
+            EXPECT_EQ(trading::shardOf(id, 3), shard);
+            EXPECT_EQ(value, static_cast<int>(id));
+            ++visited;
+        });
+    }
+    EXPECT_EQ(visited, 8);
+}
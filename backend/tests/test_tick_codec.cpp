@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "tick_codec.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace {
+
+using trading::tick_codec::ColumnDecoder;
+using trading::tick_codec::Encoding;
+using trading::tick_codec::kBlockSize;
+
+std::vector<int64_t> roundTrip(const std::vector<int64_t>& values, size_t* encoded_bytes = nullptr) {
+    std::vector<uint8_t> encoded;
+    trading::tick_codec::encodeIntegers(values, encoded);
+    if (encoded_bytes) {
+        *encoded_bytes = encoded.size();
+    }
+    ColumnDecoder decoder(encoded, values.size());
+    std::vector<int64_t> decoded(values.size());
+    decoder.decode(0, decoder.blockCount(), decoded.data());
+    return decoded;
+}
+
+std::vector<double> roundTrip(const std::vector<double>& values, Encoding expected) {
+    std::vector<uint8_t> encoded;
+    trading::tick_codec::encodeDoubles(values, encoded);
+    ColumnDecoder decoder(encoded, values.size());
+    EXPECT_EQ(decoder.encoding(), expected);
+    std::vector<double> decoded(values.size());
+    decoder.decode(0, decoder.blockCount(), decoded.data());
+    return decoded;
+}
+
+// Bitwise, so -0.0 and NaN payloads count
+bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+} // namespace
+
+TEST(TickCodecTest, RegularTimestampsPackToHeaders) {
+    std::vector<int64_t> minutes;
+    for (int64_t i = 0; i < 390; ++i) {
+        minutes.push_back(1700000000000000000LL + i * 60000000000LL);
+    }
+    size_t bytes = 0;
+    EXPECT_EQ(roundTrip(minutes, &bytes), minutes);
+    EXPECT_LT(bytes, 200u);  // Versus 3120 raw
+
+    std::mt19937_64 rng(7);
+    std::vector<int64_t> ticks{1700000000000000000LL};
+    for (int i = 1; i < 1000; ++i) {
+        ticks.push_back(ticks.back() + static_cast<int64_t>(rng() % 5000000));
+    }
+    EXPECT_EQ(roundTrip(ticks), ticks);
+}
+
+TEST(TickCodecTest, IntegersRoundTripAtEveryWidth) {
+    std::mt19937_64 rng(11);
+    for (unsigned width = 0; width <= 64; ++width) {
+        std::vector<int64_t> values(300);
+        for (auto& value : values) {
+            value = static_cast<int64_t>(width == 64 ? rng() : rng() & ((uint64_t{1} << width) - 1));
+        }
+        EXPECT_EQ(roundTrip(values), values) << "width " << width;
+    }
+    std::vector<int64_t> extremes{std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), 0,
+                                  std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()};
+    EXPECT_EQ(roundTrip(extremes), extremes);
+    EXPECT_EQ(roundTrip(std::vector<int64_t>{42}), std::vector<int64_t>{42});
+}
+
+TEST(TickCodecTest, DoublesRoundTripExactly) {
+    std::mt19937_64 rng(3);
+    std::vector<double> prices;
+    int64_t cents = 15000;
+    for (int i = 0; i < 1000; ++i) {
+        cents += static_cast<int64_t>(rng() % 11) - 5;
+        prices.push_back(static_cast<double>(cents) / 100.0);
+    }
+    EXPECT_TRUE(sameBits(roundTrip(prices, Encoding::DECIMAL), prices));
+
+    std::vector<double> noisy;
+    std::normal_distribution<double> normal;
+    for (int i = 0; i < 1000; ++i) {
+        noisy.push_back(100.0 * std::exp(normal(rng) * 0.01));
+    }
+    EXPECT_TRUE(sameBits(roundTrip(noisy, Encoding::XOR), noisy));
+
+    std::vector<double> special{1.5, -0.0, std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::infinity(), 1e300, -2.25};
+    EXPECT_TRUE(sameBits(roundTrip(special, Encoding::XOR), special));
+}
+
+TEST(TickCodecTest, DecodesSingleBlocks) {
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 1000; ++i) {
+        values.push_back(i * i);
+    }
+    std::vector<uint8_t> encoded;
+    trading::tick_codec::encodeIntegers(values, encoded);
+    ColumnDecoder decoder(encoded, values.size());
+    ASSERT_EQ(decoder.blockCount(), 8u);
+
+    // The last block is partial
+    std::vector<int64_t> block(kBlockSize);
+    decoder.decode(7, 8, block.data());
+    EXPECT_EQ(block[0], values[7 * kBlockSize]);
+    EXPECT_EQ(block[1000 - 7 * kBlockSize - 1], values.back());
+    EXPECT_EQ(decoder.firstInteger(3), values[3 * kBlockSize]);
+
+    EXPECT_THROW(ColumnDecoder(encoded, values.size() + kBlockSize), std::runtime_error);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "tick_store.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+constexpr int64_t kNanosPerDay = 86400LL * 1000000000LL;
+
+std::string tempPath(const char* name) {
+    return "/tmp/" + std::string(name) + "_" + std::to_string(::getpid()) + ".store";
+}
+
+// Minute bars for three days starting at midnight UTC of day
+std::vector<trading::MarketData> makeBars(const std::string& symbol, int64_t day, double base) {
+    std::vector<trading::MarketData> bars;
+    trading::SymbolId id = trading::internSymbol(symbol);
+    for (int64_t d = day; d < day + 3; ++d) {
+        for (int64_t minute = 0; minute < 390; ++minute) {
+            trading::MarketData bar;
+            bar.symbol_id = id;
+            bar.timestamp = trading::fromEpochNanos(d * kNanosPerDay + (570 + minute) * 60000000000LL);
+            bar.last_price = base + static_cast<double>(bars.size()) * 0.01;
+            bar.open = bar.last_price - 0.005;
+            bar.high = bar.last_price + 0.02;
+            bar.low = bar.last_price - 0.02;
+            bar.volume = 1000.0 + static_cast<double>(minute);
+            bars.push_back(bar);
+        }
+    }
+    return bars;
+}
+
+std::vector<trading::TickStore::Chunk> loadAll(const trading::TickStore& store, trading::SymbolId symbol,
+                                               std::vector<trading::TickStore::Buffer>& buffers) {
+    auto entries = store.find(symbol);
+    buffers.resize(entries.size());
+    std::vector<trading::TickStore::Chunk> chunks;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        chunks.push_back(store.load(entries[i], buffers[i]));
+    }
+    return chunks;
+}
+
+class TickStoreTest : public ::testing::TestWithParam<trading::TickStoreWriter::Compression> {};
+
+} // namespace
+
+TEST_P(TickStoreTest, RoundTripsPerSymbolDayChunks) {
+    std::string path = tempPath("tick_store_round_trip");
+    auto aapl = makeBars("STORE_AAPL", 19000, 150.0);
+    auto msft = makeBars("STORE_MSFT", 19000, 300.0);
+    {
+        trading::TickStoreWriter writer(path, GetParam());
+        writer.append(aapl, trading::TickStoreWriter::Layout::BARS);
+        writer.append(msft);
+        writer.finish();
+    }
+
+    trading::TickStore store(path);
+    EXPECT_EQ(store.symbols().size(), 2u);
+    EXPECT_EQ(store.chunkCount(), 6u);
+    EXPECT_EQ(store.tickCount(aapl[0].symbol_id), aapl.size());
+
+    std::vector<trading::TickStore::Buffer> buffers;
+    auto chunks = loadAll(store, aapl[0].symbol_id, buffers);
+    ASSERT_EQ(chunks.size(), 3u);
+    EXPECT_EQ(chunks[1].day, 19001);
+    EXPECT_TRUE(chunks[0].hasBars());
+    EXPECT_EQ(chunks[2].high[389], aapl.back().high);
+    EXPECT_FALSE(loadAll(store, msft[0].symbol_id, buffers)[0].hasBars());
+
+    std::vector<trading::MarketData> out;
+    EXPECT_EQ(store.read(msft[0].symbol_id, trading::Timestamp::min(), trading::Timestamp::max(), out),
+              msft.size());
+    for (size_t i = 0; i < msft.size(); ++i) {
+        EXPECT_EQ(out[i].timestamp, msft[i].timestamp);
+        EXPECT_EQ(out[i].last_price, msft[i].last_price);
+        EXPECT_EQ(out[i].volume, msft[i].volume);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_P(TickStoreTest, RangeQueriesTrimChunks) {
+    std::string path = tempPath("tick_store_range");
+    auto bars = makeBars("STORE_RANGE", 19000, 50.0);
+    trading::TickStoreWriter writer(path, GetParam());
+    // Split across calls: the second day spans two chunks
+    writer.append(trading::Span<const trading::MarketData>(bars.data(), 500));
+    writer.append(trading::Span<const trading::MarketData>(bars.data() + 500, bars.size() - 500));
+    writer.finish();
+
+    trading::TickStore store(path);
+    EXPECT_EQ(store.chunkCount(), 4u);
+
+    // From the middle of the first day to the middle of the second
+    std::vector<trading::MarketData> out;
+    EXPECT_EQ(store.read(bars[0].symbol_id, bars[200].timestamp, bars[600].timestamp, out), 401u);
+    EXPECT_EQ(out.front().timestamp, bars[200].timestamp);
+    EXPECT_EQ(out.back().timestamp, bars[600].timestamp);
+
+    // Bounds inside a block and across block boundaries
+    for (size_t first : {0u, 127u, 128u, 300u, 700u}) {
+        for (size_t last : {first, first + 1, first + 128, size_t{1169}}) {
+            out.clear();
+            store.read(bars[0].symbol_id, bars[first].timestamp, bars[last].timestamp, out);
+            ASSERT_EQ(out.size(), last - first + 1);
+            EXPECT_EQ(out.front().last_price, bars[first].last_price);
+            EXPECT_EQ(out.back().last_price, bars[last].last_price);
+        }
+    }
+
+    // Between sessions: nothing
+    auto gap = store.find(bars[0].symbol_id, bars[389].timestamp + std::chrono::minutes(1),
+                          bars[390].timestamp - std::chrono::minutes(1));
+    EXPECT_TRUE(gap.empty());
+    EXPECT_TRUE(store.find(trading::internSymbol("STORE_MISSING")).empty());
+    std::remove(path.c_str());
+}
+
+TEST_P(TickStoreTest, RejectsBadInput) {
+    std::string path = tempPath("tick_store_bad");
+    auto bars = makeBars("STORE_BAD", 19000, 10.0);
+    {
+        trading::TickStoreWriter writer(path, GetParam());
+        writer.append(bars);
+        EXPECT_THROW(writer.append(trading::Span<const trading::MarketData>(bars.data(), 10)),
+                     std::invalid_argument);
+        auto mixed = makeBars("STORE_BAD_OTHER", 19010, 10.0);
+        mixed[5].symbol_id = bars[0].symbol_id;
+        EXPECT_THROW(writer.append(mixed), std::invalid_argument);
+        // Not finished yet: no footer
+        EXPECT_THROW(trading::TickStore store(path), std::runtime_error);
+    }
+    // The destructor finished it
+    EXPECT_NO_THROW(trading::TickStore store(path));
+    std::remove(path.c_str());
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, TickStoreTest,
+                         ::testing::Values(trading::TickStoreWriter::Compression::NONE,
+                                           trading::TickStoreWriter::Compression::PACKED));
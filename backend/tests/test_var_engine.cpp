@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "var_engine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    // Reference parametric VaR for a list of P&L samples
+    double referenceVar(const std::vector<double>& pnl, double z) {
+        double mean = 0.0;
+        for (double x : pnl) mean += x;
+        mean /= pnl.size();
+        double variance = 0.0;
+        for (double x : pnl) variance += (x - mean) * (x - mean);
+        variance /= (pnl.size() - 1);
+        return z * std::sqrt(variance) - mean;
+    }
+}
+
+TEST(VarEngineTest, InverseNormalCdf) {
+    EXPECT_NEAR(trading::inverseNormalCdf(0.5), 0.0, 1e-9);
+    EXPECT_NEAR(trading::inverseNormalCdf(0.95), 1.6448536270, 1e-8);
+    EXPECT_NEAR(trading::inverseNormalCdf(0.99), 2.3263478740, 1e-8);
+    EXPECT_NEAR(trading::inverseNormalCdf(0.01), -2.3263478740, 1e-8);
+}
+
+TEST(VarEngineTest, SingleAssetMatchesReference) {
+    trading::VarEngine::Options options;
+    options.window = 20;
+    options.max_assets = 4;
+    options.confidence = 0.95;
+    trading::VarEngine engine(options);
+    auto symbol = trading::internSymbol("AAPL");
+
+    std::vector<double> returns{0.01, -0.02, 0.03, -0.01, 0.005, -0.015, 0.02, 0.0, -0.03, 0.012};
+    double price = 100.0;
+    engine.onPrice(symbol, price);
+    engine.sampleReturns();
+    for (double r : returns) {
+        price *= 1.0 + r;
+        engine.onPrice(symbol, price);
+        engine.sampleReturns();
+    }
+    engine.setExposure(symbol, 50000.0);
+
+    std::vector<double> pnl;
+    for (double r : returns) pnl.push_back(50000.0 * r);
+
+    trading::VarEstimate estimate = engine.evaluate();
+    EXPECT_EQ(estimate.samples, returns.size());
+    EXPECT_NEAR(estimate.parametric_var, referenceVar(pnl, trading::inverseNormalCdf(0.95)), 1e-6);
+    EXPECT_GT(estimate.parametric_cvar, estimate.parametric_var);
+    // 5% of 10 samples rounds up to the single worst outcome
+    EXPECT_NEAR(estimate.historical_var, 1500.0, 1e-6);
+    EXPECT_NEAR(estimate.historical_cvar, 1500.0, 1e-6);
+}
+
+TEST(VarEngineTest, HedgedExposureHasNoRisk) {
+    trading::VarEngine engine;
+    auto a = trading::internSymbol("HEDGE_A");
+    auto b = trading::internSymbol("HEDGE_B");
+
+    double price = 50.0;
+    for (int i = 0; i < 30; ++i) {
+        price *= (i % 3 == 0) ? 1.02 : 0.99;
+        engine.onPrice(a, price);
+        engine.onPrice(b, price * 2.0);
+        engine.sampleReturns();
+    }
+    engine.setExposure(a, 100000.0);
+    engine.setExposure(b, -100000.0);
+
+    trading::VarEstimate estimate = engine.evaluate();
+    EXPECT_NEAR(estimate.parametric_var, 0.0, 1e-6);
+    EXPECT_NEAR(estimate.historical_var, 0.0, 1e-6);
+
+    engine.setExposure(b, 0.0);
+    EXPECT_GT(engine.evaluate().parametric_var, 0.0);
+}
+
+TEST(VarEngineTest, WindowDropsOldestReturns) {
+    trading::VarEngine::Options options;
+    options.window = 3;
+    options.max_assets = 1;
+    trading::VarEngine engine(options);
+    auto symbol = trading::internSymbol("ROLL");
+
+    std::vector<double> returns{-0.5, 0.4, 0.01, -0.02, 0.03};
+    double price = 10.0;
+    engine.onPrice(symbol, price);
+    engine.sampleReturns();
+    for (double r : returns) {
+        price *= 1.0 + r;
+        engine.onPrice(symbol, price);
+        engine.sampleReturns();
+    }
+    engine.setExposure(symbol, 1000.0);
+
+    std::vector<double> pnl{10.0, -20.0, 30.0};
+    trading::VarEstimate estimate = engine.evaluate();
+    EXPECT_EQ(estimate.samples, 3u);
+    EXPECT_NEAR(estimate.parametric_var, referenceVar(pnl, trading::inverseNormalCdf(0.95)), 1e-6);
+    EXPECT_NEAR(estimate.historical_var, 20.0, 1e-6);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include "common/work_stealing_pool.hpp"
+#include <atomic>
+#include <stdexcept>
+
+TEST(WorkStealingPoolTest, RunsEveryTaskIncludingNestedOnes) {
+    trading::WorkStealingPool pool(4);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&] {
+            count.fetch_add(1);
+            // Lands on this worker's deque; idle workers steal it
+            for (int j = 0; j < 10; ++j) {
+                pool.submit([&] { count.fetch_add(1); });
+            }
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(count.load(), 1100);
+
+    pool.submit([&] { count.fetch_add(1); });
+    pool.wait();
+    EXPECT_EQ(count.load(), 1101);
+}
+
+TEST(WorkStealingPoolTest, WaitRethrowsTheFirstFailure) {
+    trading::WorkStealingPool pool(2);
+    std::atomic<int> count{0};
+    pool.submit([] { throw std::runtime_error("boom"); });
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&] { count.fetch_add(1); });
+    }
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(count.load(), 10);
+    EXPECT_NO_THROW(pool.wait());
+}
@@ -1,4 +1,5 @@
 from .backtest_engine import BacktestEngine
 from .performance_analyzer import PerformanceAnalyzer
+from .native_backtest import run_native_backtest
 
-__all__ = ['BacktestEngine', 'PerformanceAnalyzer'] 
\ No newline at end of file
+__all__ = ['BacktestEngine', 'PerformanceAnalyzer', 'run_native_backtest'] 
\ No newline at end of file
@@ -0,0 +1,51 @@
+import numpy as np
+import pandas as pd
+from typing import Any, Dict
+
+
+def run_native_backtest(data: pd.DataFrame, strategy: Any = None,
+                        initial_capital: float = 100000.0,
+                        commission_rate: float = 0.001,
+                        position_size_limit: float = 0.1) -> Dict[str, Any]:
+    """Run a backtest on the C++ engine (trading_native extension).
+
+    data: ticks indexed by timestamp with 'close' and optional 'volume' and
+    'symbol' columns. strategy: a trading_native.Strategy, by default
+    MovingAverageStrategy().
+    """
+    import trading_native
+
+    data = data.sort_index()
+    symbol_column = data['symbol'] if 'symbol' in data else pd.Series('DEFAULT', index=data.index)
+    codes, symbols = pd.factorize(symbol_column)
+    volumes = data['volume'] if 'volume' in data else pd.Series(0.0, index=data.index)
+
+    options = trading_native.BacktestOptions()
+    options.initial_capital = initial_capital
+    options.commission_rate = commission_rate
+    options.position_size_limit = position_size_limit
+    if strategy is None:
+        strategy = trading_native.MovingAverageStrategy()
+
+    engine = trading_native.BacktestEngine(strategy, options)
+    result = engine.run(pd.DatetimeIndex(data.index).asi8.astype(np.int64),
+                        codes.astype(np.int32),
+                        data['close'].to_numpy(dtype=np.float64),
+                        volumes.to_numpy(dtype=np.float64),
+                        [str(symbol) for symbol in symbols])
+
+    equity = pd.DataFrame(result.equity_curve)
+    equity.index = pd.to_datetime(equity.pop('timestamp_ns'))
+    trades = pd.DataFrame(result.trades)
+    trades['timestamp'] = pd.to_datetime(trades.pop('timestamp_ns'))
+    return {
+        'initial_capital': result.initial_capital,
+        'final_value': result.final_value,
+        'total_return': result.total_return,
+        'max_drawdown': result.max_drawdown,
+        'total_trades': result.fills,
+        'commission': result.commission,
+        'events_per_second': result.events / result.elapsed_seconds if result.elapsed_seconds else 0.0,
+        'equity_curve': equity,
+        'trades': trades,
+    }
@@ -1,9 +1,22 @@
 import yfinance as yf
 import pandas as pd
+import numpy as np
 from datetime import datetime, timedelta
-from typing import Optional
+from typing import List, Optional
 import logging
 
+# Quote record layout shared with the C++ engine (PyQuoteRecord in
+# backend/src/data_loader.cpp). align=True gives C struct padding.
+QUOTE_DTYPE = np.dtype([
+    ('symbol_index', np.int32),
+    ('open', np.float64),
+    ('high', np.float64),
+    ('low', np.float64),
+    ('close', np.float64),
+    ('volume', np.float64),
+    ('timestamp_ns', np.int64),
+], align=True)
+
 class YahooFetcher:
     """Yahoo Finance data fetcher"""
     
@@ -50,6 +63,72 @@ class YahooFetcher:
             self.logger.error(f"Error fetching data for {symbol}: {str(e)}")
             raise
 
+    def get_quotes_array(self, symbols: List[str]) -> np.ndarray:
+        """
+        Fetch the latest bar for a whole symbol universe in one request
+        :param symbols: Stock symbols
+        :return: QUOTE_DTYPE array, symbol_index refers to the position in symbols
+        """
+        try:
+            df = yf.download(
+                tickers=symbols,
+                period='1d',
+                interval='1m',
+                group_by='ticker',
+                threads=True,
+                progress=False
+            )
+
+            quotes = np.zeros(len(symbols), dtype=QUOTE_DTYPE)
+            count = 0
+            for index, symbol in enumerate(symbols):
+                bars = df[symbol] if len(symbols) > 1 else df
+                bars = bars.dropna(how='all')
+                if bars.empty:
+                    continue
+                last = bars.iloc[-1]
+                quotes[count] = (
+                    index,
+                    last['Open'],
+                    last['High'],
+                    last['Low'],
+                    last['Close'],
+                    last['Volume'],
+                    pd.Timestamp(bars.index[-1]).value
+                )
+                count += 1
+
+            return quotes[:count]
+
+        except Exception as e:
+            self.logger.error(f"Error fetching quotes for {len(symbols)} symbols: {str(e)}")
+            raise
+
+    def fetch_historical_array(
+        self,
+        symbol: str,
+        start_time: Optional[datetime] = None,
+        end_time: Optional[datetime] = None,
+        interval: str = '1d'
+    ) -> np.ndarray:
+        """
+        Fetch historical data as a QUOTE_DTYPE array for the C++ engine
+        :param symbol: Stock symbol
+        :param start_time: Start time
+        :param end_time: End time
+        :param interval: Time interval
+        :return: QUOTE_DTYPE array with symbol_index 0
+        """
+        df = self.fetch_historical_data(symbol, start_time, end_time, interval)
+        quotes = np.zeros(len(df), dtype=QUOTE_DTYPE)
+        quotes['open'] = df['open'].to_numpy()
+        quotes['high'] = df['high'].to_numpy()
+        quotes['low'] = df['low'].to_numpy()
+        quotes['close'] = df['close'].to_numpy()
+        quotes['volume'] = df['volume'].to_numpy()
+        quotes['timestamp_ns'] = pd.DatetimeIndex(df.index).asi8
+        return quotes
+
     def get_company_info(self, symbol: str) -> dict:
         """Fetch company information"""
         try:
@@ -1,9 +1,10 @@
+import numpy as np
 import pandas as pd
 import json
 import pickle
 import os
 from pathlib import Path
-from typing import Dict, Any, Optional, Union
+from typing import Dict, Any, Iterator, List, Optional, Union
 from datetime import datetime
 import logging
 
@@ -46,7 +47,80 @@ class FileStorage:
         except Exception as e:
             self.logger.error(f"Load market data CSV error: {e}")
             return None
-    
+
+    def save_market_data_store(self, frames: Dict[str, pd.DataFrame],
+                               filename: str = "market_data.store") -> str:
+        """Save per-symbol OHLCV frames to a native columnar tick store
+
+        Each frame is indexed by timestamp with 'close' and 'volume' and
+        optionally 'open', 'high', 'low' columns. Needs the trading_native
+        extension.
+        """
+        try:
+            import trading_native
+
+            filepath = self.base_path / "market_data" / filename
+            writer = trading_native.TickStoreWriter(str(filepath))
+            for symbol, df in frames.items():
+                df = df.sort_index()
+                bars = {column: df[column].to_numpy(dtype=np.float64)
+                        for column in ("open", "high", "low") if column in df}
+                writer.append(symbol,
+                              pd.DatetimeIndex(df.index).asi8.astype(np.int64),
+                              df["close"].to_numpy(dtype=np.float64),
+                              df["volume"].to_numpy(dtype=np.float64),
+                              **(bars if len(bars) == 3 else {}))
+            writer.finish()
+            self.logger.info(f"Market data saved to tick store: {filepath}")
+            return str(filepath)
+        except Exception as e:
+            self.logger.error(f"Save market data store error: {e}")
+            return ""
+
+    def load_market_data_store(self, filepath: str, symbol: str,
+                               start: Optional[datetime] = None,
+                               end: Optional[datetime] = None) -> Optional[pd.DataFrame]:
+        """Load one symbol's range from a native columnar tick store"""
+        try:
+            import trading_native
+
+            store = trading_native.TickStore(filepath)
+            columns = store.read(symbol,
+                                 pd.Timestamp(start).value if start is not None else None,
+                                 pd.Timestamp(end).value if end is not None else None)
+            index = pd.to_datetime(columns.pop("timestamp_ns"))
+            df = pd.DataFrame(columns, index=index).rename(columns={"price": "close"})
+            return df
+        except Exception as e:
+            self.logger.error(f"Load market data store error: {e}")
+            return None
+
+    def stream_market_data_store(self, filepath: str, symbols: List[str],
+                                 start: Optional[datetime] = None,
+                                 end: Optional[datetime] = None,
+                                 batch_size: int = 16384) -> Iterator[pd.DataFrame]:
+        """Iterate over symbols' ticks from a native tick store in time order
+
+        Yields one DataFrame per batch of at most batch_size rows, with a
+        'symbol' column, so ranges larger than memory can be processed
+        batch by batch. The next batches are decoded in the background.
+        """
+        try:
+            import trading_native
+
+            stream = trading_native.HistoricalStream(
+                filepath, list(symbols),
+                pd.Timestamp(start).value if start is not None else None,
+                pd.Timestamp(end).value if end is not None else None,
+                batch_size)
+            names = np.array(stream.symbols, dtype=object)
+            for columns in stream:
+                index = pd.to_datetime(columns.pop("timestamp_ns"))
+                columns["symbol"] = names[columns.pop("symbol_index")]
+                yield pd.DataFrame(columns, index=index).rename(columns={"price": "close"})
+        except Exception as e:
+            self.logger.error(f"Stream market data store error: {e}")
+
     def save_trades_json(self, trades: list, filename: Optional[str] = None) -> str:
         """Save trade records to JSON file"""
         try: